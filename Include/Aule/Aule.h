@@ -22,6 +22,17 @@
 
 namespace Aule
 {
+    // Internal state of optional subsystems, owned by the context.
+    struct FrameCapture;
+    struct TextureStreamer;
+    struct CommandCache;
+    struct GpuCulling;
+    struct DynamicResolution;
+    struct ImguiTextureCache;
+    struct InputRecorder;
+    struct ResourceRegistry;
+    struct FileLoader;
+
     struct Params
     {
         // Basic operating system window information.
@@ -34,12 +45,54 @@ namespace Aule
         const char* deviceHint = nullptr;
 
         // Attempt to load this list of Vulkan extensions. Log a warning if
-        // extension is not found in driver.
+        // extension is not found in driver, see IsDeviceExtensionEnabled.
         std::vector<const char*> deviceExtensions;
 
         // Due to how ImGui Vulkan images work we need to specify descriptor
         // pool size.
         uint32_t maxSupportedImguiImages = 512u;
+
+        // Descriptor sets the ImGui texture cache may hold, see
+        // GetImguiTexture. Must leave room in the pool for ImGui's own
+        // textures and any sets the application allocates itself.
+        uint32_t imguiTextureCacheSize = 256u;
+
+        // Initialize ImGui and render its UI pass every frame. Has no effect
+        // when Aule is built without AULE_ENABLE_IMGUI.
+        bool enableImgui = true;
+    };
+
+    struct WindowParams
+    {
+        const char* windowName;
+        uint32_t    windowWidth;
+        uint32_t    windowHeight;
+    };
+
+    // An additional operating system window presenting from the context's
+    // device, see AddWindow.
+    struct Window
+    {
+        GLFWwindow* window;
+
+        VkSurfaceKHR             surface;
+        VkSurfaceCapabilitiesKHR surfaceInfo;
+        VkSwapchainKHR           swapchain;
+
+        uint32_t                 frameImageCount;
+        VkFormat                 frameImageFormat;
+        std::vector<VkImage>     frameImages;
+        std::vector<VkImageView> frameImageViews;
+
+        // Index into `frameImages` acquired for the frame currently being
+        // recorded.
+        uint32_t frameImageIndex;
+
+        // Index with the `frameIndex` passed by the Dispatch callback.
+        std::vector<VkSemaphore> frameSemaphoreImageAvailable;
+
+        // Set by RemoveWindow, the window is destroyed before the next frame.
+        bool pendingRemoval;
     };
 
     struct Context
@@ -63,6 +116,10 @@ namespace Aule
         std::vector<VkQueueFamilyProperties>  queueFamilyProperties;
         std::unordered_map<uint32_t, VkQueue> queues;
 
+        // Internal extensions and the supported subset of
+        // Params::deviceExtensions the device was created with.
+        std::vector<std::string> enabledDeviceExtensions;
+
         // Context will use the first queue family that supports graphics for
         // imgui, graphics commands, swapchain present. Commands that get
         // recorded in the render lambda will be submitted to this queue.
@@ -79,6 +136,7 @@ namespace Aule
 
         // Index with the `frameIndex` passed by the Dispatch callback.
         uint32_t                                       frameImageCount;
+        VkFormat                                       frameImageFormat;
         std::vector<VkImage>                           frameImages;
         std::vector<VkImageView>                       frameImageViews;
         std::vector<VkCommandPool>                     frameCommandPool;
@@ -87,6 +145,350 @@ namespace Aule
         std::vector<VkSemaphore>                       frameSemaphoreRenderComplete;
         std::vector<VkFence>                           frameFenceRenderComplete;
         std::vector<std::deque<std::function<void()>>> frameDeletionQueues;
+
+        // Whether ImGui was initialized, in which case Dispatch renders the UI
+        // pass on top of the swapchain image every frame.
+        bool imguiEnabled;
+
+        // Number of frames dispatched so far, the frame slot being recorded
+        // and the swapchain image acquired for it (index into `frameImages`).
+        uint64_t frameNumber;
+        uint32_t frameIndex;
+        uint32_t frameImageIndex;
+
+        // Seconds since the previous frame, or the fixed delta time while an
+        // input replay runs.
+        float frameDeltaTime;
+
+        // Additional windows sharing this device, see AddWindow.
+        std::vector<Window*> windows;
+
+        // Active asynchronous frame capture, see BeginCapture.
+        FrameCapture* pCapture;
+
+        // Mip residency streamer, see CreateTextureStreamer.
+        TextureStreamer* pTextureStreamer;
+
+        // Pre-recorded secondary command buffers, see ExecuteCachedCommands.
+        CommandCache* pCommandCache;
+
+        // Compute culling and indirect draw module, see CreateGpuCulling.
+        GpuCulling* pGpuCulling;
+
+        // Offscreen render target scaled to a GPU time budget, see
+        // EnableDynamicResolution.
+        DynamicResolution* pDynamicResolution;
+
+        // ImGui texture IDs by image view and sampler, see GetImguiTexture.
+        ImguiTextureCache* pImguiTextureCache;
+
+        // Active input recording or replay, see BeginInputRecording.
+        InputRecorder* pInput;
+
+        // Objects behind generational handles, see CreateBuffer.
+        ResourceRegistry* pResources;
+
+        // Memory-mapped file uploads, see CreateFileLoader.
+        FileLoader* pFileLoader;
+    };
+
+    struct ComputeParams
+    {
+        const char* applicationName = "Aule";
+
+        // Try to initialize with a device that contains this string in its
+        // description.
+        const char* deviceHint = nullptr;
+
+        // Optional Vulkan extensions, like Params::deviceExtensions.
+        std::vector<const char*> deviceExtensions;
+
+        // Command buffers in flight. BeginComputeBatch only waits when the
+        // batch recorded this many submissions ago hasn't finished yet.
+        uint32_t batchesInFlight = 2u;
+    };
+
+    // A device, queue and allocator for offline compute work, without a
+    // window, swapchain or ImGui, see CreateComputeContext.
+    struct ComputeContext
+    {
+        VkInstance instance;
+        VkDevice   device;
+
+        VkPhysicalDevice           selectedPhysicalDevice;
+        VkPhysicalDeviceProperties selectedPhysicalDeviceProperties;
+
+        // One queue is created from each of the queue families, like Context.
+        uint32_t                              queueFamilyCount;
+        std::vector<VkQueueFamilyProperties>  queueFamilyProperties;
+        std::unordered_map<uint32_t, VkQueue> queues;
+
+        std::vector<std::string> enabledDeviceExtensions;
+
+        // The first compute family without graphics support, or the first
+        // compute family if the device has no dedicated one. Batches are
+        // submitted to this queue.
+        uint32_t selectedQueueFamilyIndex;
+
+        VmaAllocator allocator;
+
+        // Signaled with the value returned by SubmitComputeBatch once that
+        // batch completes.
+        VkSemaphore timelineSemaphore;
+        uint64_t    submittedValue;
+
+        // Index with `batchIndex`, the slot being recorded.
+        uint32_t                                       batchCount;
+        uint32_t                                       batchIndex;
+        std::vector<VkCommandPool>                     batchCommandPool;
+        std::vector<VkCommandBuffer>                   batchCommandBuffer;
+        std::vector<uint64_t>                          batchTimelineValue;
+        std::vector<std::deque<std::function<void()>>> batchDeletionQueues;
+
+        bool recording;
+    };
+
+    enum class CaptureFormat
+    {
+        // Tightly packed texels exactly as copied out of the image.
+        Raw,
+
+        // 8-bit RGB PNG. Only 8-bit RGBA / BGRA formats can be encoded, other
+        // formats are written raw.
+        PNG
+    };
+
+    struct CaptureResult
+    {
+        uint64_t    frameNumber;
+        VkFormat    format;
+        VkExtent2D  extent;
+        const void* pData;
+        size_t      size;
+    };
+
+    struct CaptureParams
+    {
+        // Each capture is written to "<outputPrefix><frameNumber>.<ext>",
+        // producing an image sequence.
+        const char*   outputPrefix = "Capture_";
+        CaptureFormat format       = CaptureFormat::PNG;
+
+        // Number of host-visible readback buffers in the ring. When every
+        // buffer is either in flight or waiting on the encoder the capture is
+        // skipped instead of stalling the frame. Zero picks frameImageCount + 2.
+        uint32_t ringSize = 0u;
+
+        // Copy the swapchain image (including UI) of every dispatched frame.
+        bool captureSwapchain = true;
+
+        // Optional consumer called on the encoder thread instead of writing
+        // files. Data is only valid for the duration of the call.
+        std::function<void(const CaptureResult&)> onCapture;
+    };
+
+    struct CaptureStatistics
+    {
+        uint64_t captured;
+        uint64_t skipped;
+    };
+
+    struct TextureStreamerParams
+    {
+        // Least recently used mips are evicted once streamed textures would
+        // exceed this many bytes of device memory.
+        VkDeviceSize vramBudget = 512ull << 20u;
+
+        // Number of the smallest mips that always stay resident.
+        uint32_t minResidentMips = 1u;
+
+        // Limit on mip loads in flight on the streaming thread, and on
+        // residency changes recorded per frame.
+        uint32_t maxPendingLoads    = 16u;
+        uint32_t maxUploadsPerFrame = 4u;
+    };
+
+    struct StreamedTextureDesc
+    {
+        VkFormat format;
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipCount;
+
+        // Called on the streaming thread to write one mip level's tightly
+        // packed texels (`size` bytes) into `pDestination`.
+        std::function<void(uint32_t mip, void* pDestination, size_t size)> loadMip;
+    };
+
+    // Index of a texture registered with the streamer.
+    using StreamedTexture = uint32_t;
+
+    struct TextureStreamerStatistics
+    {
+        VkDeviceSize residentBytes;
+        uint64_t     streamedMips;
+        uint64_t     evictedMips;
+    };
+
+    struct GpuCullingParams
+    {
+        // Capacity of the per-frame draw buffers.
+        uint32_t maxInstances = 1u << 17u;
+    };
+
+    // Layout of an element in the mesh buffer (std430).
+    struct GpuCullingMesh
+    {
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t  vertexOffset;
+        uint32_t padding;
+    };
+
+    struct GpuCullingInput
+    {
+        // Storage buffers of GpuCullingMesh, one uint32_t mesh index per
+        // instance, and one world space bounding sphere (xyz center, w radius)
+        // per instance. Writes to them must be visible to compute shaders.
+        VkBuffer meshBuffer;
+        VkBuffer instanceBuffer;
+        VkBuffer boundsBuffer;
+        uint32_t instanceCount;
+
+        glm::mat4 viewProjection;
+
+        // Optional occlusion culling against last frame's depth pyramid: each
+        // texel holds the farthest depth (0 near, 1 far) of its footprint, mip
+        // 0 at half the depth buffer resolution or less. The view must be in
+        // SHADER_READ_ONLY_OPTIMAL and is tested with the view projection the
+        // pyramid was rendered with.
+        VkImageView depthPyramid;
+        VkExtent2D  depthPyramidExtent;
+        uint32_t    depthPyramidMipCount;
+        glm::mat4   previousViewProjection;
+    };
+
+    struct GpuCullingStatistics
+    {
+        // Frame the numbers were read back from.
+        uint64_t frameNumber;
+        uint32_t instances;
+        uint32_t drawn;
+        uint32_t frustumCulled;
+        uint32_t occlusionCulled;
+    };
+
+    struct DynamicResolutionParams
+    {
+        // GPU time of the whole frame command buffer to aim for.
+        float targetFrameTimeMs = 1000.0f / 60.0f;
+
+        // Bounds of the per-axis render scale relative to the swapchain
+        // extent. The target is allocated at `maxScale`.
+        float minScale = 0.5f;
+        float maxScale = 1.0f;
+
+        // Defaults to the swapchain format.
+        VkFormat format = VK_FORMAT_UNDEFINED;
+
+        // Filter used to upscale the target into the swapchain image.
+        VkFilter filter = VK_FILTER_LINEAR;
+    };
+
+    struct DynamicResolutionTarget
+    {
+        VkImage     image;
+        VkImageView imageView;
+        VkFormat    format;
+
+        // Render only into [0, renderExtent), the rest of the image is unused.
+        VkExtent2D renderExtent;
+    };
+
+    struct DynamicResolutionStatistics
+    {
+        float      scale;
+        float      gpuFrameTimeMs;
+        VkExtent2D renderExtent;
+    };
+
+    struct ImguiTextureCacheStatistics
+    {
+        uint32_t cachedTextures;
+        uint64_t createdSets;
+        uint64_t recycledSets;
+        uint64_t evictedTextures;
+
+        // Requests that found every set in use by the current frame.
+        uint64_t misses;
+    };
+
+    struct InputReplayParams
+    {
+        // File written by BeginInputRecording.
+        const char* inputPath;
+
+        // Delta time reported to ImGui and `Context::frameDeltaTime` every
+        // replayed frame, regardless of how long the frame actually took.
+        float fixedDeltaTime = 1.0f / 60.0f;
+
+        // CSV with the measured wall time of every replayed frame.
+        const char* timingPath = "InputReplayTiming.csv";
+
+        // Close the main window once every recorded frame was replayed, which
+        // returns from Dispatch.
+        bool closeWindowOnEnd = true;
+    };
+
+    struct FileLoaderParams
+    {
+        // Bounded pool the I/O thread stages file data through when it can't
+        // be imported with VK_EXT_external_memory_host.
+        VkDeviceSize stagingChunkSize  = 16ull << 20u;
+        uint32_t     stagingChunkCount = 8u;
+
+        // Largest range of a file imported at once. Importing pins the pages,
+        // reading them in, and is done on the I/O thread.
+        VkDeviceSize maxImportSize = 256ull << 20u;
+
+        // Copy commands recorded into a frame command buffer. At least one
+        // copy is recorded per frame regardless.
+        VkDeviceSize maxCopyBytesPerFrame = 256ull << 20u;
+    };
+
+    using FileLoad = uint64_t;
+
+    struct FileLoaderStatistics
+    {
+        // Bytes copied straight out of imported file mappings, and through
+        // the staging pool.
+        uint64_t importedBytes;
+        uint64_t stagedBytes;
+
+        uint32_t pendingLoads;
+    };
+
+    // 32-bit generational handles into the context's resource registry: the
+    // low 20 bits index a slot, the high 12 bits hold the slot's generation.
+    // Zero is never a valid handle.
+    struct BufferHandle
+    {
+        uint32_t value = 0u;
+    };
+
+    struct ImageHandle
+    {
+        uint32_t value = 0u;
+    };
+
+    struct ImageViewHandle
+    {
+        uint32_t value = 0u;
+    };
+
+    struct SamplerHandle
+    {
+        uint32_t value = 0u;
     };
 
     // Create's an operating system window and Vulkan runtime, with a linking
@@ -98,12 +500,259 @@ namespace Aule
     // Destroy provided operating system window and Vulkan runtime.
     void DestroyContext(Context& context);
 
+    // Create a Vulkan runtime without window, surface or ImGui for compute
+    // workloads. Shares the device and allocator setup of CreateContext.
+    ComputeContext CreateComputeContext(const ComputeParams& params);
+
+    // Waits for every submitted batch and destroys the runtime.
+    void DestroyComputeContext(ComputeContext& context);
+
+    // Begin recording the next batch into its slot's command buffer. Only
+    // waits on the GPU if the slot is still in flight, after which the slot's
+    // deletion queue is flushed. Record any number of dispatches into it.
+    VkCommandBuffer BeginComputeBatch(ComputeContext& context);
+
+    // Submit the batch without waiting for it. Returns the timeline value the
+    // batch signals on completion.
+    uint64_t SubmitComputeBatch(ComputeContext& context);
+
+    // Wait until the batch that returned `value` completes. False on timeout.
+    bool WaitComputeBatch(const ComputeContext& context,
+                          uint64_t              value,
+                          uint64_t              timeout = UINT64_MAX);
+
+    // Timeline value of the most recent completed batch.
+    uint64_t GetCompletedComputeBatch(const ComputeContext& context);
+
+    bool IsDeviceExtensionEnabled(const ComputeContext& context, const char* extension);
+
+    // Whether an extension was requested and the device supports it.
+    bool IsDeviceExtensionEnabled(const Context& context, const char* extension);
+
     // Dispatch a renderloop handling swapchain, frames in flight, basic
     // synchronization. and call back the user render function to fill out
     // commands for current frame. Callback MUST transfer the current swapchain
-    // image to PRESENT.
+    // image to PRESENT, unless dynamic resolution is enabled.
     void Dispatch(Context&                                 context,
                   std::function<void(uint32_t frameIndex)> renderFrameCallback,
                   std::mutex*                              pDispatchQueueMutex = nullptr);
 
+    // Open an additional window with its own surface and swapchain on the
+    // context's device and allocator. Every window is acquired each frame and
+    // presented together with the main window in a single vkQueuePresentKHR.
+    // Like the main window, the Dispatch callback MUST transfer the window's
+    // current image (`frameImages[frameImageIndex]`) to PRESENT.
+    Window* AddWindow(Context& context, const WindowParams& params);
+
+    // Flag a window for destruction. It is no longer acquired or presented
+    // from the next frame on. Safe to call from the Dispatch callback.
+    void RemoveWindow(Context& context, Window* pWindow);
+
+    // Start streaming frame captures into a ring of readback buffers. Results
+    // are picked up once the frame fence signals and handed to a background
+    // encoder thread, the render loop never waits on the GPU for them.
+    void BeginCapture(Context& context, const CaptureParams& params);
+
+    // Wait for outstanding captures to be encoded and release the ring.
+    void EndCapture(Context& context);
+
+    // Record a copy of `image` into the frame command buffer. The image must be
+    // in TRANSFER_SRC_OPTIMAL or GENERAL with prior writes made visible to
+    // transfer. Returns false if the copy was skipped because the encoder
+    // can't keep up.
+    bool CaptureImage(Context&      context,
+                      uint32_t      frameIndex,
+                      VkImage       image,
+                      VkImageLayout imageLayout,
+                      VkFormat      format,
+                      VkExtent2D    extent);
+
+    CaptureStatistics GetCaptureStatistics(const Context& context);
+
+    // Create the context's texture streamer. Streamed textures only keep
+    // their smallest mips resident at first, finer mips are loaded on a
+    // background thread as the application requests them and uploaded through
+    // a staging buffer (on a dedicated transfer queue when the device has one).
+    // The streamer is destroyed with the context.
+    void CreateTextureStreamer(Context& context, const TextureStreamerParams& params);
+
+    StreamedTexture AddStreamedTexture(Context& context, const StreamedTextureDesc& desc);
+
+    void RemoveStreamedTexture(Context& context, StreamedTexture texture);
+
+    // Per-frame feedback from the Dispatch callback: the finest mip the
+    // application wants to sample, acted on at the start of the next frame.
+    // Textures that aren't requested become candidates for eviction.
+    void RequestStreamedTextureMip(Context& context, StreamedTexture texture, uint32_t mip);
+
+    // View over the resident mips, level 0 of which is the finest resident mip
+    // of the texture. Null until the first mips are uploaded, and replaced
+    // whenever residency changes, so query it every frame. The image is always
+    // in VK_IMAGE_LAYOUT_GENERAL.
+    VkImageView GetStreamedTextureView(const Context& context, StreamedTexture texture);
+
+    // Finest mip currently resident, in the texture's full mip chain.
+    uint32_t GetStreamedTextureResidentMip(const Context& context, StreamedTexture texture);
+
+    TextureStreamerStatistics GetTextureStreamerStatistics(const Context& context);
+
+    // Execute a static recording identified by `id` in the frame command
+    // buffer. The recording is kept as a secondary command buffer per frame
+    // slot and is only re-recorded, through `recordCallback`, when `key`
+    // differs from the key it was last recorded with. Pass `pRenderingInfo`
+    // to execute inside a vkCmdBeginRendering scope begun with
+    // VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT.
+    void ExecuteCachedCommands(Context&                                         context,
+                               uint32_t                                         frameIndex,
+                               uint64_t                                         id,
+                               uint64_t                                         key,
+                               const std::function<void(VkCommandBuffer cmd)>& recordCallback,
+                               const VkCommandBufferInheritanceRenderingInfo* pRenderingInfo =
+                                   nullptr);
+
+    // Force the recording to be re-recorded the next time it is executed.
+    void InvalidateCachedCommands(Context& context, uint64_t id);
+
+    // Release a recording once the frames that may still execute it finish.
+    void ReleaseCachedCommands(Context& context, uint64_t id);
+
+    // Render into an offscreen target whose resolution follows a GPU time
+    // budget, measured with timestamps around the frame command buffer. Once
+    // enabled, the Dispatch callback renders into GetDynamicResolutionTarget
+    // instead of the swapchain: the target is handed over in
+    // COLOR_ATTACHMENT_OPTIMAL and must be left in it. Dispatch then upscales
+    // it into the swapchain image ahead of the UI pass, and the callback must
+    // no longer touch the swapchain image.
+    void EnableDynamicResolution(Context& context, const DynamicResolutionParams& params);
+
+    // Return to rendering straight into the swapchain from the next frame on.
+    // Safe to call from the Dispatch callback.
+    void DisableDynamicResolution(Context& context);
+
+    // Target and render extent for the frame being recorded.
+    DynamicResolutionTarget GetDynamicResolutionTarget(const Context& context);
+
+    DynamicResolutionStatistics GetDynamicResolutionStatistics(const Context& context);
+
+    // Record the main window's key, text, mouse, focus and resize events to a
+    // binary file, each stamped with the frame it was polled for. Events still
+    // reach the previously installed GLFW callbacks (ImGui's backend).
+    void BeginInputRecording(Context& context, const char* outputPath);
+
+    void EndInputRecording(Context& context);
+
+    // Replay a recording from the next frame on. Live input is ignored while
+    // the recorded events are fed to the installed GLFW callbacks on the
+    // frames they were recorded for, with a fixed delta time. With ImGui
+    // enabled they are fed to ImGui's IO instead of the callbacks.
+    void BeginInputReplay(Context& context, const InputReplayParams& params);
+
+    void EndInputReplay(Context& context);
+
+    bool IsReplayingInput(const Context& context);
+
+    // Create objects owned by the context's resource registry. Buffers and
+    // images are allocated with the context allocator; mapped buffers keep
+    // their pointer. Destroying a handle invalidates it at once and releases
+    // the object once the frames that may still use it complete. Looking up a
+    // destroyed handle throws. The registry is not thread safe.
+    BufferHandle CreateBuffer(Context&                       context,
+                              const VkBufferCreateInfo&      bufferInfo,
+                              const VmaAllocationCreateInfo& allocationInfo);
+
+    ImageHandle CreateImage(Context&                       context,
+                            const VkImageCreateInfo&       imageInfo,
+                            const VmaAllocationCreateInfo& allocationInfo);
+
+    // `imageViewInfo.image` is taken from `image`.
+    ImageViewHandle CreateImageView(Context&                     context,
+                                    ImageHandle                  image,
+                                    const VkImageViewCreateInfo& imageViewInfo);
+
+    SamplerHandle CreateSampler(Context& context, const VkSamplerCreateInfo& samplerInfo);
+
+    void DestroyBuffer(Context& context, BufferHandle buffer);
+    void DestroyImage(Context& context, ImageHandle image);
+    void DestroyImageView(Context& context, ImageViewHandle imageView);
+    void DestroySampler(Context& context, SamplerHandle sampler);
+
+    bool IsValid(const Context& context, BufferHandle buffer);
+    bool IsValid(const Context& context, ImageHandle image);
+    bool IsValid(const Context& context, ImageViewHandle imageView);
+    bool IsValid(const Context& context, SamplerHandle sampler);
+
+    VkBuffer      GetBuffer(const Context& context, BufferHandle buffer);
+    VmaAllocation GetBufferAllocation(const Context& context, BufferHandle buffer);
+    VkDeviceSize  GetBufferSize(const Context& context, BufferHandle buffer);
+    void*         GetBufferMappedData(const Context& context, BufferHandle buffer);
+
+    VkImage       GetImage(const Context& context, ImageHandle image);
+    VmaAllocation GetImageAllocation(const Context& context, ImageHandle image);
+    VkFormat      GetImageFormat(const Context& context, ImageHandle image);
+    VkExtent3D    GetImageExtent(const Context& context, ImageHandle image);
+
+    VkImageView GetImageView(const Context& context, ImageViewHandle imageView);
+    VkSampler   GetSampler(const Context& context, SamplerHandle sampler);
+
+    // Create the context's file loader. Files are mapped read-only. If
+    // VK_EXT_external_memory_host is in Params::deviceExtensions and supported,
+    // a background I/O thread imports the mappings as transfer source buffers,
+    // copied to the GPU without a CPU copy. Otherwise, for the unaligned tail
+    // of a file and for ranges the driver refuses to import, that thread
+    // streams the data through the staging pool. The loader is destroyed with
+    // the context.
+    void CreateFileLoader(Context& context, const FileLoaderParams& params);
+
+    // Copy a whole file into `dstBuffer` at `dstOffset`. The buffer needs
+    // TRANSFER_DST usage and room for the file. Copies are recorded into the
+    // frame command buffers of the next Dispatch calls, ahead of the callback,
+    // and are followed by a memory barrier. Throws if the file can't be mapped.
+    FileLoad LoadFileToBuffer(Context&     context,
+                              const char*  path,
+                              VkBuffer     dstBuffer,
+                              VkDeviceSize dstOffset = 0u);
+
+    // True once the frames holding the load's copies have completed.
+    bool IsFileLoadComplete(const Context& context, FileLoad load);
+
+    FileLoaderStatistics GetFileLoaderStatistics(const Context& context);
+
+#ifdef AULE_ENABLE_IMGUI
+    // ImGui texture ID for an image view and sampler, for use with ImGui::Image
+    // this frame. Descriptor sets are created on first use and the least
+    // recently used ones are evicted and rewritten for new images once the
+    // frames that drew them complete. Returns ImTextureID_Invalid when no set
+    // is free yet, the image should be skipped this frame.
+    ImTextureID GetImguiTexture(Context&      context,
+                                VkImageView   imageView,
+                                VkSampler     sampler,
+                                VkImageLayout imageLayout =
+                                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    // Drop every cached texture of the image view, e.g. before destroying it.
+    void ReleaseImguiTexture(Context& context, VkImageView imageView);
+
+    ImguiTextureCacheStatistics GetImguiTextureCacheStatistics(const Context& context);
+#endif
+
+#ifdef AULE_ENABLE_GPU_CULLING
+    // Create the context's GPU culling module. Draw and count buffers are
+    // allocated per frame in flight from the context allocator. The module is
+    // destroyed with the context.
+    void CreateGpuCulling(Context& context, const GpuCullingParams& params);
+
+    // Record the culling compute pass into the frame command buffer, writing a
+    // compacted VkDrawIndexedIndirectCommand per visible instance with
+    // `firstInstance` set to the instance index. Call once per frame, outside
+    // of a rendering scope.
+    void CullInstances(Context& context, uint32_t frameIndex, const GpuCullingInput& input);
+
+    // Issue vkCmdDrawIndexedIndirectCount over the visible instances. The
+    // pipeline, index and vertex buffers must already be bound.
+    void DrawCulledInstances(Context& context, uint32_t frameIndex);
+
+    // Statistics of the most recent frame whose results have been read back.
+    GpuCullingStatistics GetGpuCullingStatistics(const Context& context);
+#endif
+
 } // namespace Aule
@@ -50,7 +50,7 @@ int main(int argc, char** argv)
                        [&](uint32_t frameIndex)
                        {
                            auto& cmd        = context.frameCommandBuffer[frameIndex];
-                           auto& backbuffer = context.frameImages[frameIndex];
+                           auto& backbuffer = context.frameImages[context.frameImageIndex];
 
                            // -----
 
@@ -104,7 +104,9 @@ int main(int argc, char** argv)
 
                            // -----
 
+#ifdef AULE_ENABLE_IMGUI
                            ImGui::ShowDemoWindow();
+#endif
                        });
 
         Aule::DestroyContext(context);
@@ -20,144 +20,117 @@
  * SOFTWARE.
  */
 
-#include "../Include/Aule/Aule.h"
+#include "AuleInternal.h"
 
 using namespace Aule;
 
-inline void ThrowOnFail(bool succeeded)
-{
-    if (!succeeded)
-        throw std::runtime_error("Internal Vulkan call failed.");
-}
-
-inline void ThrowOnFail(VkResult result) { ThrowOnFail(result == VK_SUCCESS); }
-
 // Implementation
 // -----------------------
 
-Context Aule::CreateContext(const Params& params)
+void Aule::Internal::FlushDeletionQueue(std::deque<std::function<void()>>& deletionQueue)
 {
-    Context ctx = {};
-
-    assert(params.windowName != nullptr);
-    assert(params.windowWidth != 0);
-    assert(params.windowHeight != 0);
-
-    // ----------------------------------
-
-#ifdef __linux__
-    // X11 is better than Wayland in this case due to better RADV tracing support.
-    // And also a weird bug in imgui scaling that I am too lazy to fix at the moment.
-    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
-#endif
-
-    ThrowOnFail(glfwInit());
-
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-
-    ctx.window = glfwCreateWindow(params.windowWidth,
-                                  params.windowHeight,
-                                  params.windowName,
-                                  nullptr,
-                                  nullptr);
-
-    ThrowOnFail(ctx.window);
-
-    ThrowOnFail(volkInitialize());
+    while (!deletionQueue.empty())
+    {
+        // Execute the stored lambda (e.g., vkDestroyBuffer)
+        deletionQueue.front()();
 
-    // ----------------------------------
+        deletionQueue.pop_front();
+    }
+}
 
+VkInstance Aule::Internal::CreateInstance(const char*        applicationName,
+                                          const char* const* ppExtensions,
+                                          uint32_t           extensionCount)
+{
     VkApplicationInfo applicationInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
     {
-        applicationInfo.pApplicationName   = params.windowName;
+        applicationInfo.pApplicationName   = applicationName;
         applicationInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
         applicationInfo.pEngineName        = "Aule";
         applicationInfo.engineVersion      = VK_MAKE_VERSION(0, 0, 0);
         applicationInfo.apiVersion         = VK_API_VERSION_1_3;
     }
 
-    uint32_t requiredExtensionsCountGLFW;
-    auto requiredExtensionsGLFW = glfwGetRequiredInstanceExtensions(&requiredExtensionsCountGLFW);
-
     VkInstanceCreateInfo instanceInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
     {
         instanceInfo.pApplicationInfo        = &applicationInfo;
-        instanceInfo.enabledExtensionCount   = requiredExtensionsCountGLFW;
-        instanceInfo.ppEnabledExtensionNames = requiredExtensionsGLFW;
+        instanceInfo.enabledExtensionCount   = extensionCount;
+        instanceInfo.ppEnabledExtensionNames = ppExtensions;
     }
 
-    ThrowOnFail(vkCreateInstance(&instanceInfo, nullptr, &ctx.instance));
+    VkInstance instance;
+    ThrowOnFail(vkCreateInstance(&instanceInfo, nullptr, &instance));
 
-    volkLoadInstance(ctx.instance);
+    volkLoadInstance(instance);
 
-    // ----------------------------------
+    return instance;
+}
 
+void Aule::Internal::SelectPhysicalDevice(VkInstance                            instance,
+                                          const char*                           deviceHint,
+                                          VkPhysicalDevice&                     physicalDevice,
+                                          VkPhysicalDeviceProperties&           properties,
+                                          std::vector<VkQueueFamilyProperties>& queueFamilies)
+{
     uint32_t physicalDeviceCount;
-    ThrowOnFail(vkEnumeratePhysicalDevices(ctx.instance, &physicalDeviceCount, nullptr));
+    ThrowOnFail(vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, nullptr));
 
     // No drivers found!
     ThrowOnFail(physicalDeviceCount > 0);
 
     std::vector<VkPhysicalDevice> physicalDevices(physicalDeviceCount);
-    ThrowOnFail(
-        vkEnumeratePhysicalDevices(ctx.instance, &physicalDeviceCount, physicalDevices.data()));
+    ThrowOnFail(vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, physicalDevices.data()));
 
-    ctx.selectedPhysicalDevice = VK_NULL_HANDLE;
+    physicalDevice = VK_NULL_HANDLE;
 
-    if (params.deviceHint != nullptr)
+    if (deviceHint != nullptr)
     {
         for (auto& device : physicalDevices)
         {
             VkPhysicalDeviceProperties deviceInfo;
             vkGetPhysicalDeviceProperties(device, &deviceInfo);
 
-            if (!strstr(deviceInfo.deviceName, params.deviceHint))
+            if (!strstr(deviceInfo.deviceName, deviceHint))
                 continue;
 
-            ctx.selectedPhysicalDevice = device;
+            physicalDevice = device;
 
             break;
         }
     }
 
     // Default to device zero if no hint is provided or does not match.
-    if (ctx.selectedPhysicalDevice == VK_NULL_HANDLE)
-        ctx.selectedPhysicalDevice = physicalDevices[0];
+    if (physicalDevice == VK_NULL_HANDLE)
+        physicalDevice = physicalDevices[0];
 
     // Store the properties for the user.
-    vkGetPhysicalDeviceProperties(ctx.selectedPhysicalDevice,
-                                  &ctx.selectedPhysicalDeviceProperties);
-
-    vkGetPhysicalDeviceQueueFamilyProperties(ctx.selectedPhysicalDevice,
-                                             &ctx.queueFamilyCount,
-                                             nullptr);
-
-    ctx.queueFamilyProperties.resize(ctx.queueFamilyCount);
-    vkGetPhysicalDeviceQueueFamilyProperties(ctx.selectedPhysicalDevice,
-                                             &ctx.queueFamilyCount,
-                                             ctx.queueFamilyProperties.data());
-
-    for (uint32_t queueFamilyIndex = 0u; queueFamilyIndex < ctx.queueFamilyCount;
-         queueFamilyIndex++)
-    {
-        if (!(ctx.queueFamilyProperties[queueFamilyIndex].queueFlags & VK_QUEUE_GRAPHICS_BIT))
-            continue;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
 
-        // Just grab first graphics compatible queue.
-        ctx.selectedQueueFamilyIndex = queueFamilyIndex;
-    }
+    uint32_t queueFamilyCount;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
 
-    // ----------------------------------
+    queueFamilies.resize(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice,
+                                             &queueFamilyCount,
+                                             queueFamilies.data());
+}
 
+VkDevice Aule::Internal::CreateDevice(VkPhysicalDevice                       physicalDevice,
+                                      uint32_t                               queueFamilyCount,
+                                      const std::vector<const char*>&        requiredExtensions,
+                                      const std::vector<const char*>&        requestedExtensions,
+                                      const void*                            pFeatures,
+                                      std::unordered_map<uint32_t, VkQueue>& queues,
+                                      std::vector<std::string>&              enabledExtensions)
+{
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos(
-        ctx.queueFamilyCount,
+        queueFamilyCount,
         { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO });
 
     // Currently we make no effort to prioritize one over the other...
     const float kQueuePriority = 1.0f;
 
-    for (uint32_t queueFamilyIndex = 0u; queueFamilyIndex < ctx.queueFamilyCount;
-         queueFamilyIndex++)
+    for (uint32_t queueFamilyIndex = 0u; queueFamilyIndex < queueFamilyCount; queueFamilyIndex++)
     {
         // ONE queue will be created for each family.
         queueCreateInfos[queueFamilyIndex].queueFamilyIndex = queueFamilyIndex;
@@ -165,30 +138,16 @@ Context Aule::CreateContext(const Params& params)
         queueCreateInfos[queueFamilyIndex].pQueuePriorities = &kQueuePriority;
     }
 
-    VkDeviceCreateInfo deviceInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
-
-    std::vector<const char*> extensions;
-    {
-        extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
-        extensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
-        extensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
-
-        // Emplace user-requested extenstions.
-        extensions.insert(extensions.end(),
-                          params.deviceExtensions.begin(),
-                          params.deviceExtensions.end());
-    }
-
-    // First check.
+    std::vector<const char*> extensions = requiredExtensions;
     {
         uint32_t supportedDeviceExtensionCount = 0;
-        vkEnumerateDeviceExtensionProperties(ctx.selectedPhysicalDevice,
+        vkEnumerateDeviceExtensionProperties(physicalDevice,
                                              nullptr,
                                              &supportedDeviceExtensionCount,
                                              nullptr);
 
         std::vector<VkExtensionProperties> supportedDeviceExtensions(supportedDeviceExtensionCount);
-        vkEnumerateDeviceExtensionProperties(ctx.selectedPhysicalDevice,
+        vkEnumerateDeviceExtensionProperties(physicalDevice,
                                              nullptr,
                                              &supportedDeviceExtensionCount,
                                              supportedDeviceExtensions.data());
@@ -204,74 +163,173 @@ Context Aule::CreateContext(const Params& params)
             return false;
         };
 
-        for (const auto& requestedExtension : extensions)
-            ThrowOnFail(DeviceExtensionSupported(requestedExtension));
-    }
+        for (const auto& requiredExtension : requiredExtensions)
+            ThrowOnFail(DeviceExtensionSupported(requiredExtension));
 
-    VkPhysicalDeviceFeatures2                features                = {};
-    VkPhysicalDeviceSynchronization2Features featureSync2            = {};
-    VkPhysicalDeviceDynamicRenderingFeatures featureDynamicRendering = {};
+        // Application extensions are optional, unsupported ones are skipped.
+        for (const auto& requestedExtension : requestedExtensions)
+        {
+            if (!DeviceExtensionSupported(requestedExtension))
+            {
+                fprintf(stderr,
+                        "Aule: device extension %s is not supported, skipping it.\n",
+                        requestedExtension);
 
-    features.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-    featureSync2.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
-    featureDynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+                continue;
+            }
 
-    features.pNext     = &featureSync2;
-    featureSync2.pNext = &featureDynamicRendering;
+            extensions.push_back(requestedExtension);
+        }
+    }
 
-    featureSync2.synchronization2            = VK_TRUE;
-    featureDynamicRendering.dynamicRendering = VK_TRUE;
+    enabledExtensions.assign(extensions.begin(), extensions.end());
 
-    deviceInfo.pNext                   = &features;
-    deviceInfo.queueCreateInfoCount    = queueCreateInfos.size();
-    deviceInfo.pQueueCreateInfos       = queueCreateInfos.data();
-    deviceInfo.enabledExtensionCount   = extensions.size();
-    deviceInfo.ppEnabledExtensionNames = extensions.data();
+    VkDeviceCreateInfo deviceInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+    {
+        deviceInfo.pNext                   = pFeatures;
+        deviceInfo.queueCreateInfoCount    = queueCreateInfos.size();
+        deviceInfo.pQueueCreateInfos       = queueCreateInfos.data();
+        deviceInfo.enabledExtensionCount   = extensions.size();
+        deviceInfo.ppEnabledExtensionNames = extensions.data();
+    }
 
-    ThrowOnFail(vkCreateDevice(ctx.selectedPhysicalDevice, &deviceInfo, nullptr, &ctx.device));
+    VkDevice device;
+    ThrowOnFail(vkCreateDevice(physicalDevice, &deviceInfo, nullptr, &device));
 
-    volkLoadDevice(ctx.device);
+    volkLoadDevice(device);
 
-    for (uint32_t queueFamilyIndex = 0u; queueFamilyIndex < ctx.queueFamilyCount;
-         queueFamilyIndex++)
+    for (uint32_t queueFamilyIndex = 0u; queueFamilyIndex < queueFamilyCount; queueFamilyIndex++)
     {
         // Load queues into the map
-        vkGetDeviceQueue(ctx.device, queueFamilyIndex, 0u, &ctx.queues[queueFamilyIndex]);
+        vkGetDeviceQueue(device, queueFamilyIndex, 0u, &queues[queueFamilyIndex]);
     }
 
-    // Surface
-    // ---------------------
+    return device;
+}
 
-    ThrowOnFail(glfwCreateWindowSurface(ctx.instance, ctx.window, nullptr, &ctx.surface));
+VmaAllocator Aule::Internal::CreateAllocator(VkInstance       instance,
+                                             VkPhysicalDevice physicalDevice,
+                                             VkDevice         device)
+{
+    VmaVulkanFunctions allocatorFunctions = {};
+    {
+        allocatorFunctions.vkGetInstanceProcAddr = vkGetInstanceProcAddr;
+        allocatorFunctions.vkGetDeviceProcAddr   = vkGetDeviceProcAddr;
+    }
+
+    VmaAllocatorCreateInfo allocatorInfo = {};
+    {
+        allocatorInfo.instance         = instance;
+        allocatorInfo.device           = device;
+        allocatorInfo.physicalDevice   = physicalDevice;
+        allocatorInfo.pVulkanFunctions = &allocatorFunctions;
+    }
+
+    VmaAllocator allocator;
+    ThrowOnFail(vmaCreateAllocator(&allocatorInfo, &allocator));
+
+    return allocator;
+}
+
+uint32_t Aule::Internal::GetTexelSize(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_R8_UNORM:
+        case VK_FORMAT_R8_SRGB: return 1u;
+
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R16_SFLOAT: return 2u;
+
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+        case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+        case VK_FORMAT_R32_SFLOAT: return 4u;
+
+        case VK_FORMAT_R16G16B16A16_SFLOAT: return 8u;
+
+        case VK_FORMAT_R32G32B32A32_SFLOAT: return 16u;
+
+        default: return 0u;
+    }
+}
+
+VkDeviceSize Aule::Internal::GetImageSize(VkFormat format, uint32_t width, uint32_t height)
+{
+    uint32_t blockSize;
+
+    switch (format)
+    {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK: blockSize = 8u; break;
+
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK: blockSize = 16u; break;
+
+        default:
+            return static_cast<VkDeviceSize>(width) * height * GetTexelSize(format);
+    }
+
+    // Block compressed formats are stored in 4x4 texel blocks.
+    return static_cast<VkDeviceSize>((width + 3u) / 4u) * ((height + 3u) / 4u) * blockSize;
+}
+
+// Creates the surface, swapchain and swapchain image views for an operating
+// system window on the context's device.
+static void CreateWindowSwapchain(const Context& ctx,
+                                  Window&        window,
+                                  uint32_t       width,
+                                  uint32_t       height)
+{
+    ThrowOnFail(glfwCreateWindowSurface(ctx.instance, window.window, nullptr, &window.surface));
+
+    // All windows present from the selected graphics queue.
+    VkBool32 presentSupported = VK_FALSE;
+    ThrowOnFail(vkGetPhysicalDeviceSurfaceSupportKHR(ctx.selectedPhysicalDevice,
+                                                     ctx.selectedQueueFamilyIndex,
+                                                     window.surface,
+                                                     &presentSupported));
+    ThrowOnFail(presentSupported == VK_TRUE);
 
     uint32_t surfaceFormatCount;
     ThrowOnFail(vkGetPhysicalDeviceSurfaceFormatsKHR(ctx.selectedPhysicalDevice,
-                                                     ctx.surface,
+                                                     window.surface,
                                                      &surfaceFormatCount,
                                                      nullptr));
 
     std::vector<VkSurfaceFormatKHR> surfaceFormats(surfaceFormatCount);
     ThrowOnFail(vkGetPhysicalDeviceSurfaceFormatsKHR(ctx.selectedPhysicalDevice,
-                                                     ctx.surface,
+                                                     window.surface,
                                                      &surfaceFormatCount,
                                                      surfaceFormats.data()));
     ThrowOnFail(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(ctx.selectedPhysicalDevice,
-                                                          ctx.surface,
-                                                          &ctx.surfaceInfo));
+                                                          window.surface,
+                                                          &window.surfaceInfo));
 
     VkSwapchainCreateInfoKHR swapChainInfo = { VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR };
 
 #if defined(__linux__)
-    ctx.surfaceInfo.currentExtent.width  = params.windowWidth;
-    ctx.surfaceInfo.currentExtent.height = params.windowHeight;
+    window.surfaceInfo.currentExtent.width  = width;
+    window.surfaceInfo.currentExtent.height = height;
 #endif
 
     {
         swapChainInfo.presentMode         = VK_PRESENT_MODE_FIFO_KHR;
-        swapChainInfo.surface             = ctx.surface;
-        swapChainInfo.minImageCount       = ctx.surfaceInfo.minImageCount;
-        swapChainInfo.imageExtent         = ctx.surfaceInfo.currentExtent;
-        swapChainInfo.preTransform        = ctx.surfaceInfo.currentTransform;
+        swapChainInfo.surface             = window.surface;
+        swapChainInfo.minImageCount       = window.surfaceInfo.minImageCount;
+        swapChainInfo.imageExtent         = window.surfaceInfo.currentExtent;
+        swapChainInfo.preTransform        = window.surfaceInfo.currentTransform;
         swapChainInfo.pQueueFamilyIndices = &ctx.selectedQueueFamilyIndex;
         swapChainInfo.imageColorSpace     = surfaceFormats.at(0).colorSpace;
         swapChainInfo.imageFormat         = surfaceFormats.at(0).format;
@@ -279,11 +337,223 @@ Context Aule::CreateContext(const Params& params)
         swapChainInfo.imageUsage =
             VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         swapChainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+
+        // Needed to read back the swapchain for frame captures.
+        if (window.surfaceInfo.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+            swapChainInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     }
 
-    ThrowOnFail(vkCreateSwapchainKHR(ctx.device, &swapChainInfo, nullptr, &ctx.swapchain));
+    window.frameImageFormat = swapChainInfo.imageFormat;
+
+    ThrowOnFail(vkCreateSwapchainKHR(ctx.device, &swapChainInfo, nullptr, &window.swapchain));
+
+    ThrowOnFail(
+        vkGetSwapchainImagesKHR(ctx.device, window.swapchain, &window.frameImageCount, nullptr));
+
+    window.frameImages.resize(window.frameImageCount);
+    window.frameImageViews.resize(window.frameImageCount);
 
-    ThrowOnFail(vkGetSwapchainImagesKHR(ctx.device, ctx.swapchain, &ctx.frameImageCount, nullptr));
+    ThrowOnFail(vkGetSwapchainImagesKHR(ctx.device,
+                                        window.swapchain,
+                                        &window.frameImageCount,
+                                        window.frameImages.data()));
+
+    for (uint32_t imageIndex = 0u; imageIndex < window.frameImageCount; imageIndex++)
+    {
+        VkImageViewCreateInfo imageViewInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+
+        imageViewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        imageViewInfo.image                           = window.frameImages[imageIndex];
+        imageViewInfo.format                          = swapChainInfo.imageFormat;
+        imageViewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageViewInfo.subresourceRange.baseMipLevel   = 0u;
+        imageViewInfo.subresourceRange.levelCount     = 1u;
+        imageViewInfo.subresourceRange.baseArrayLayer = 0u;
+        imageViewInfo.subresourceRange.layerCount     = 1u;
+        imageViewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                          VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                          VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                          VK_COMPONENT_SWIZZLE_IDENTITY };
+
+        ThrowOnFail(vkCreateImageView(ctx.device,
+                                      &imageViewInfo,
+                                      nullptr,
+                                      &window.frameImageViews[imageIndex]));
+    }
+}
+
+static void DestroyWindow(const Context& ctx, Window* pWindow)
+{
+    for (auto& frameImageView : pWindow->frameImageViews)
+        vkDestroyImageView(ctx.device, frameImageView, nullptr);
+
+    for (auto& semaphore : pWindow->frameSemaphoreImageAvailable)
+        vkDestroySemaphore(ctx.device, semaphore, nullptr);
+
+    vkDestroySwapchainKHR(ctx.device, pWindow->swapchain, nullptr);
+    vkDestroySurfaceKHR(ctx.instance, pWindow->surface, nullptr);
+
+    glfwDestroyWindow(pWindow->window);
+
+    delete pWindow;
+}
+
+// Destroys windows flagged by RemoveWindow. Swapchains can't be tracked by
+// frame fences once presented, so this waits for the queue to drain.
+static void ProcessWindowRemovals(Context& ctx)
+{
+    auto pendingRemoval = [](const Window* pWindow) { return pWindow->pendingRemoval; };
+
+    if (std::none_of(ctx.windows.begin(), ctx.windows.end(), pendingRemoval))
+        return;
+
+    vkQueueWaitIdle(ctx.queues[ctx.selectedQueueFamilyIndex]);
+
+    for (auto it = ctx.windows.begin(); it != ctx.windows.end();)
+    {
+        if (!(*it)->pendingRemoval)
+        {
+            it++;
+            continue;
+        }
+
+        DestroyWindow(ctx, *it);
+
+        it = ctx.windows.erase(it);
+    }
+}
+
+Context Aule::CreateContext(const Params& params)
+{
+    Context ctx = {};
+
+    assert(params.windowName != nullptr);
+    assert(params.windowWidth != 0);
+    assert(params.windowHeight != 0);
+
+    // ----------------------------------
+
+#ifdef __linux__
+    // X11 is better than Wayland in this case due to better RADV tracing support.
+    // And also a weird bug in imgui scaling that I am too lazy to fix at the moment.
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
+#endif
+
+    ThrowOnFail(glfwInit());
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    ctx.window = glfwCreateWindow(params.windowWidth,
+                                  params.windowHeight,
+                                  params.windowName,
+                                  nullptr,
+                                  nullptr);
+
+    ThrowOnFail(ctx.window);
+
+    ThrowOnFail(volkInitialize());
+
+    // ----------------------------------
+
+    uint32_t requiredExtensionsCountGLFW;
+    auto requiredExtensionsGLFW = glfwGetRequiredInstanceExtensions(&requiredExtensionsCountGLFW);
+
+    ctx.instance = Internal::CreateInstance(params.windowName,
+                                            requiredExtensionsGLFW,
+                                            requiredExtensionsCountGLFW);
+
+    // ----------------------------------
+
+    Internal::SelectPhysicalDevice(ctx.instance,
+                                   params.deviceHint,
+                                   ctx.selectedPhysicalDevice,
+                                   ctx.selectedPhysicalDeviceProperties,
+                                   ctx.queueFamilyProperties);
+
+    ctx.queueFamilyCount = static_cast<uint32_t>(ctx.queueFamilyProperties.size());
+
+    for (uint32_t queueFamilyIndex = 0u; queueFamilyIndex < ctx.queueFamilyCount;
+         queueFamilyIndex++)
+    {
+        if (!(ctx.queueFamilyProperties[queueFamilyIndex].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+            continue;
+
+        // Just grab first graphics compatible queue.
+        ctx.selectedQueueFamilyIndex = queueFamilyIndex;
+    }
+
+    // ----------------------------------
+
+    std::vector<const char*> extensions;
+    {
+        extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        extensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+        extensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+    }
+
+    VkPhysicalDeviceFeatures2                features                = {};
+    VkPhysicalDeviceSynchronization2Features featureSync2            = {};
+    VkPhysicalDeviceDynamicRenderingFeatures featureDynamicRendering = {};
+
+    features.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    featureSync2.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    featureDynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+
+    features.pNext     = &featureSync2;
+    featureSync2.pNext = &featureDynamicRendering;
+
+    featureSync2.synchronization2            = VK_TRUE;
+    featureDynamicRendering.dynamicRendering = VK_TRUE;
+
+#ifdef AULE_ENABLE_GPU_CULLING
+    // Culled instances are drawn with a single multi-draw indirect count.
+    VkPhysicalDeviceVulkan12Features featureVulkan12 = {};
+
+    featureVulkan12.sType         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    featureDynamicRendering.pNext = &featureVulkan12;
+
+    // Only enable what the device supports, CreateGpuCulling checks for the
+    // rest so devices without them can still run everything else.
+    VkPhysicalDeviceVulkan12Features supportedVulkan12 = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES
+    };
+
+    VkPhysicalDeviceFeatures2 supportedFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+    {
+        supportedFeatures.pNext = &supportedVulkan12;
+    }
+    vkGetPhysicalDeviceFeatures2(ctx.selectedPhysicalDevice, &supportedFeatures);
+
+    featureVulkan12.drawIndirectCount   = supportedVulkan12.drawIndirectCount;
+    features.features.multiDrawIndirect = supportedFeatures.features.multiDrawIndirect;
+    features.features.drawIndirectFirstInstance =
+        supportedFeatures.features.drawIndirectFirstInstance;
+#endif
+
+    ctx.device = Internal::CreateDevice(ctx.selectedPhysicalDevice,
+                                        ctx.queueFamilyCount,
+                                        extensions,
+                                        params.deviceExtensions,
+                                        &features,
+                                        ctx.queues,
+                                        ctx.enabledDeviceExtensions);
+
+    // Surface
+    // ---------------------
+
+    Window mainWindow = {};
+    {
+        mainWindow.window = ctx.window;
+    }
+    CreateWindowSwapchain(ctx, mainWindow, params.windowWidth, params.windowHeight);
+
+    ctx.surface          = mainWindow.surface;
+    ctx.surfaceInfo      = mainWindow.surfaceInfo;
+    ctx.swapchain        = mainWindow.swapchain;
+    ctx.frameImageCount  = mainWindow.frameImageCount;
+    ctx.frameImageFormat = mainWindow.frameImageFormat;
+    ctx.frameImages      = std::move(mainWindow.frameImages);
+    ctx.frameImageViews  = std::move(mainWindow.frameImageViews);
 
     // ---------------------
 
@@ -291,8 +561,6 @@ Context Aule::CreateContext(const Params& params)
     // always equal swap chain image count.
     const auto frameCount = ctx.frameImageCount;
 
-    ctx.frameImages.resize(frameCount);
-    ctx.frameImageViews.resize(frameCount);
     ctx.frameCommandPool.resize(frameCount);
     ctx.frameCommandBuffer.resize(frameCount);
     ctx.frameSemaphoreImageAvailable.resize(frameCount);
@@ -300,11 +568,6 @@ Context Aule::CreateContext(const Params& params)
     ctx.frameFenceRenderComplete.resize(frameCount);
     ctx.frameDeletionQueues.resize(frameCount);
 
-    ThrowOnFail(vkGetSwapchainImagesKHR(ctx.device,
-                                        ctx.swapchain,
-                                        &ctx.frameImageCount,
-                                        ctx.frameImages.data()));
-
     for (uint32_t frameIndex = 0u; frameIndex < frameCount; frameIndex++)
     {
         VkSemaphoreCreateInfo sempahoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
@@ -344,73 +607,55 @@ Context Aule::CreateContext(const Params& params)
         ThrowOnFail(vkAllocateCommandBuffers(ctx.device,
                                              &commandAllocateInfo,
                                              &ctx.frameCommandBuffer[frameIndex]));
-
-        VkImageViewCreateInfo imageViewInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
-
-        imageViewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
-        imageViewInfo.image                           = ctx.frameImages[frameIndex];
-        imageViewInfo.format                          = swapChainInfo.imageFormat;
-        imageViewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-        imageViewInfo.subresourceRange.baseMipLevel   = 0u;
-        imageViewInfo.subresourceRange.levelCount     = 1u;
-        imageViewInfo.subresourceRange.baseArrayLayer = 0u;
-        imageViewInfo.subresourceRange.layerCount     = 1u;
-        imageViewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY,
-                                                          VK_COMPONENT_SWIZZLE_IDENTITY,
-                                                          VK_COMPONENT_SWIZZLE_IDENTITY,
-                                                          VK_COMPONENT_SWIZZLE_IDENTITY };
-
-        ThrowOnFail(vkCreateImageView(ctx.device,
-                                      &imageViewInfo,
-                                      nullptr,
-                                      &ctx.frameImageViews[frameIndex]));
     }
 
     // Memory Allocator
     // ----------------------
 
-    VmaVulkanFunctions allocatorFunctions = {};
-    {
-        allocatorFunctions.vkGetInstanceProcAddr = vkGetInstanceProcAddr;
-        allocatorFunctions.vkGetDeviceProcAddr   = vkGetDeviceProcAddr;
-    }
+    ctx.allocator =
+        Internal::CreateAllocator(ctx.instance, ctx.selectedPhysicalDevice, ctx.device);
 
-    VmaAllocatorCreateInfo allocatorInfo = {};
-    {
-        allocatorInfo.instance         = ctx.instance;
-        allocatorInfo.device           = ctx.device;
-        allocatorInfo.physicalDevice   = ctx.selectedPhysicalDevice;
-        allocatorInfo.pVulkanFunctions = &allocatorFunctions;
-    }
-    ThrowOnFail(vmaCreateAllocator(&allocatorInfo, &ctx.allocator));
+    Internal::CreateResourceRegistry(ctx);
 
     // -----------------------
 
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
+#ifdef AULE_ENABLE_IMGUI
+    ctx.imguiEnabled = params.enableImgui;
 
-    ImGui_ImplGlfw_InitForVulkan(ctx.window, true);
-
-    ImGui_ImplVulkan_InitInfo imguiInfo = {};
+    if (ctx.imguiEnabled)
     {
-        imguiInfo.Instance            = ctx.instance;
-        imguiInfo.PhysicalDevice      = ctx.selectedPhysicalDevice;
-        imguiInfo.Device              = ctx.device;
-        imguiInfo.QueueFamily         = ctx.selectedQueueFamilyIndex;
-        imguiInfo.Queue               = ctx.queues[ctx.selectedQueueFamilyIndex];
-        imguiInfo.MinImageCount       = ctx.frameImageCount;
-        imguiInfo.ImageCount          = ctx.frameImageCount;
-        imguiInfo.UseDynamicRendering = true;
-        imguiInfo.DescriptorPoolSize  = params.maxSupportedImguiImages;
-
-        imguiInfo.PipelineInfoMain.PipelineRenderingCreateInfo.sType =
-            VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
-        imguiInfo.PipelineInfoMain.PipelineRenderingCreateInfo.colorAttachmentCount = 1u;
-        imguiInfo.PipelineInfoMain.PipelineRenderingCreateInfo.pColorAttachmentFormats =
-            &swapChainInfo.imageFormat;
-    }
+        IMGUI_CHECKVERSION();
+        ImGui::CreateContext();
+
+        ImGui_ImplGlfw_InitForVulkan(ctx.window, true);
 
-    ImGui_ImplVulkan_Init(&imguiInfo);
+        ImGui_ImplVulkan_InitInfo imguiInfo = {};
+        {
+            imguiInfo.Instance            = ctx.instance;
+            imguiInfo.PhysicalDevice      = ctx.selectedPhysicalDevice;
+            imguiInfo.Device              = ctx.device;
+            imguiInfo.QueueFamily         = ctx.selectedQueueFamilyIndex;
+            imguiInfo.Queue               = ctx.queues[ctx.selectedQueueFamilyIndex];
+            imguiInfo.MinImageCount       = ctx.frameImageCount;
+            imguiInfo.ImageCount          = ctx.frameImageCount;
+            imguiInfo.UseDynamicRendering = true;
+            imguiInfo.DescriptorPoolSize  = params.maxSupportedImguiImages;
+
+            imguiInfo.PipelineInfoMain.PipelineRenderingCreateInfo.sType =
+                VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+            imguiInfo.PipelineInfoMain.PipelineRenderingCreateInfo.colorAttachmentCount = 1u;
+            imguiInfo.PipelineInfoMain.PipelineRenderingCreateInfo.pColorAttachmentFormats =
+                &ctx.frameImageFormat;
+        }
+
+        ImGui_ImplVulkan_Init(&imguiInfo);
+
+        // ImGui allocates its own textures from the same pool.
+        ThrowOnFail(params.imguiTextureCacheSize < params.maxSupportedImguiImages);
+
+        Internal::CreateImguiTextureCache(ctx, params.imguiTextureCacheSize);
+    }
+#endif
 
     // -----------------------
 
@@ -419,8 +664,36 @@ Context Aule::CreateContext(const Params& params)
 
 void Aule::DestroyContext(Context& context)
 {
+    if (context.pCapture)
+        EndCapture(context);
+
+    EndInputRecording(context);
+    EndInputReplay(context);
+
     vkDeviceWaitIdle(context.device);
 
+    for (auto& frameDeletionQueue : context.frameDeletionQueues)
+        Internal::FlushDeletionQueue(frameDeletionQueue);
+
+    Internal::DestroyTextureStreamer(context);
+
+    Internal::DestroyFileLoader(context);
+
+    Internal::DestroyCommandCache(context);
+
+    Internal::DestroyDynamicResolution(context);
+
+    Internal::DestroyResourceRegistry(context);
+
+#ifdef AULE_ENABLE_GPU_CULLING
+    Internal::DestroyGpuCulling(context);
+#endif
+
+    for (auto* pWindow : context.windows)
+        DestroyWindow(context, pWindow);
+
+    context.windows.clear();
+
     for (auto& swapchainImageView : context.frameImageViews)
         vkDestroyImageView(context.device, swapchainImageView, nullptr);
 
@@ -436,8 +709,15 @@ void Aule::DestroyContext(Context& context)
         vkDestroyFence(context.device, context.frameFenceRenderComplete[frameIndex], nullptr);
     }
 
-    ImGui_ImplVulkan_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
+#ifdef AULE_ENABLE_IMGUI
+    if (context.imguiEnabled)
+    {
+        Internal::DestroyImguiTextureCache(context);
+
+        ImGui_ImplVulkan_Shutdown();
+        ImGui_ImplGlfw_Shutdown();
+    }
+#endif
 
     vkDestroySwapchainKHR(context.device, context.swapchain, nullptr);
     vkDestroySurfaceKHR(context.instance, context.surface, nullptr);
@@ -448,16 +728,85 @@ void Aule::DestroyContext(Context& context)
     glfwDestroyWindow(context.window);
 }
 
+bool Aule::IsDeviceExtensionEnabled(const Context& context, const char* extension)
+{
+    const auto& extensions = context.enabledDeviceExtensions;
+
+    return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+}
+
+Window* Aule::AddWindow(Context& context, const WindowParams& params)
+{
+    assert(params.windowName != nullptr);
+    assert(params.windowWidth != 0);
+    assert(params.windowHeight != 0);
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    auto* pWindow = new Window();
+
+    pWindow->window = glfwCreateWindow(params.windowWidth,
+                                       params.windowHeight,
+                                       params.windowName,
+                                       nullptr,
+                                       nullptr);
+
+    ThrowOnFail(pWindow->window);
+
+    CreateWindowSwapchain(context, *pWindow, params.windowWidth, params.windowHeight);
+
+    // Acquire semaphores follow the context's frames in flight, not the
+    // window's own swapchain image count.
+    pWindow->frameSemaphoreImageAvailable.resize(context.frameCommandBuffer.size());
+
+    for (auto& semaphore : pWindow->frameSemaphoreImageAvailable)
+    {
+        VkSemaphoreCreateInfo sempahoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+        ThrowOnFail(vkCreateSemaphore(context.device, &sempahoreInfo, nullptr, &semaphore));
+    }
+
+    context.windows.push_back(pWindow);
+
+    return pWindow;
+}
+
+void Aule::RemoveWindow(Context& context, Window* pWindow)
+{
+    assert(std::find(context.windows.begin(), context.windows.end(), pWindow) !=
+           context.windows.end());
+
+    pWindow->pendingRemoval = true;
+}
+
 void Aule::Dispatch(Context&                      ctx,
                     std::function<void(uint32_t)> renderFrameCallback,
                     std::mutex*                   pDispatchQueueMutex)
 {
     uint32_t frameIndex = 0u;
 
+    // Scratch for the batched submit / present, reused across frames.
+    std::vector<VkSemaphore>          waitSemaphores;
+    std::vector<VkPipelineStageFlags> waitStages;
+    std::vector<VkSwapchainKHR>       presentSwapchains;
+    std::vector<uint32_t>             presentImageIndices;
+
+    auto previousFrameTime = glfwGetTime();
+
     while (!glfwWindowShouldClose(ctx.window))
     {
+        const auto frameTime = glfwGetTime();
+
+        ctx.frameDeltaTime = static_cast<float>(frameTime - previousFrameTime);
+        previousFrameTime  = frameTime;
+
+        // Replayed events go out ahead of the live ones, which the replay
+        // swallows.
+        Internal::UpdateInput(ctx);
+
         glfwPollEvents();
 
+        ProcessWindowRemovals(ctx);
+
         // Pause thread until graphics queue finished processing.
         vkWaitForFences(ctx.device,
                         1u,
@@ -466,17 +815,9 @@ void Aule::Dispatch(Context&                      ctx,
                         UINT64_MAX);
 
         // Process deletion queue.
-        {
-            auto& frameDeletionQueue = ctx.frameDeletionQueues[frameIndex];
+        Internal::FlushDeletionQueue(ctx.frameDeletionQueues[frameIndex]);
 
-            while (!frameDeletionQueue.empty())
-            {
-                // Execute the stored lambda (e.g., vkDestroyBuffer)
-                frameDeletionQueue.front()();
-
-                frameDeletionQueue.pop_front();
-            }
-        }
+        ctx.frameIndex = frameIndex;
 
         // Reset the fence for this frame.
         vkResetFences(ctx.device, 1u, &ctx.frameFenceRenderComplete[frameIndex]);
@@ -495,16 +836,61 @@ void Aule::Dispatch(Context&                      ctx,
         ThrowOnFail(
             vkAcquireNextImage2KHR(ctx.device, &swapChainIndexAcquireInfo, &swapchainIndex));
 
+        ctx.frameImageIndex = swapchainIndex;
+
+        waitSemaphores      = { ctx.frameSemaphoreImageAvailable[frameIndex] };
+        waitStages          = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        presentSwapchains   = { ctx.swapchain };
+        presentImageIndices = { swapchainIndex };
+
+        // Additional windows are acquired alongside the main window and
+        // presented with it in a single call. Windows added while recording
+        // this frame join on the next one.
+        for (auto* pWindow : ctx.windows)
+        {
+            swapChainIndexAcquireInfo.swapchain = pWindow->swapchain;
+            swapChainIndexAcquireInfo.semaphore = pWindow->frameSemaphoreImageAvailable[frameIndex];
+
+            ThrowOnFail(vkAcquireNextImage2KHR(ctx.device,
+                                               &swapChainIndexAcquireInfo,
+                                               &pWindow->frameImageIndex));
+
+            waitSemaphores.push_back(swapChainIndexAcquireInfo.semaphore);
+            waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+            presentSwapchains.push_back(pWindow->swapchain);
+            presentImageIndices.push_back(pWindow->frameImageIndex);
+        }
+
         ThrowOnFail(vkResetCommandPool(ctx.device, ctx.frameCommandPool[frameIndex], 0x0));
 
         VkCommandBufferBeginInfo cmdInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
         ThrowOnFail(vkBeginCommandBuffer(ctx.frameCommandBuffer[frameIndex], &cmdInfo));
 
+        // Residency changes land before the callback, so new mips can be
+        // sampled this frame.
+        if (auto uploadSemaphore = Internal::UpdateTextureStreamer(ctx, frameIndex))
+        {
+            waitSemaphores.push_back(uploadSemaphore);
+            waitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        }
+
+        Internal::UpdateFileLoader(ctx, frameIndex);
+
+        Internal::BeginDynamicResolution(ctx, frameIndex);
+
         // -----------------------
 
-        ImGui_ImplVulkan_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
+#ifdef AULE_ENABLE_IMGUI
+        if (ctx.imguiEnabled)
+        {
+            ImGui_ImplVulkan_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+
+            if (IsReplayingInput(ctx))
+                ImGui::GetIO().DeltaTime = ctx.frameDeltaTime;
+            ImGui::NewFrame();
+        }
+#endif
 
         // -----------------------
 
@@ -514,16 +900,15 @@ void Aule::Dispatch(Context&                      ctx,
 
         VkImageMemoryBarrier2 imageBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
         {
-            imageBarrier.image         = ctx.frameImages[swapchainIndex];
-            imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-            imageBarrier.newLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            imageBarrier.srcAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
-            imageBarrier.dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
-            imageBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT;
-            imageBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            imageBarrier.image                       = ctx.frameImages[swapchainIndex];
             imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
             imageBarrier.subresourceRange.layerCount = 1u;
             imageBarrier.subresourceRange.levelCount = 1u;
+
+            // The callback leaves the image in PRESENT.
+            imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+            imageBarrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
+            imageBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
         }
 
         VkDependencyInfo barriers = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
@@ -532,59 +917,106 @@ void Aule::Dispatch(Context&                      ctx,
             barriers.pImageMemoryBarriers    = &imageBarrier;
         }
 
-        vkCmdPipelineBarrier2(ctx.frameCommandBuffer[frameIndex], &barriers);
-
-        VkRenderingAttachmentInfo attachmentInfo = { VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO };
+        // The offscreen target is upscaled into the image ahead of the UI, so
+        // the UI stays at native resolution.
+        if (Internal::ResolveDynamicResolution(ctx, frameIndex, ctx.frameImages[swapchainIndex]))
         {
-            attachmentInfo.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            attachmentInfo.loadOp      = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-            attachmentInfo.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
-            attachmentInfo.imageView   = ctx.frameImageViews[swapchainIndex];
+            imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            imageBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            imageBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_BLIT_BIT;
         }
 
-        VkRenderingInfo renderingInfo = { VK_STRUCTURE_TYPE_RENDERING_INFO };
+#ifdef AULE_ENABLE_IMGUI
+        if (ctx.imguiEnabled)
         {
-            renderingInfo.colorAttachmentCount = 1u;
-            renderingInfo.pColorAttachments    = &attachmentInfo;
-            renderingInfo.layerCount           = 1u;
-            renderingInfo.renderArea.extent    = ctx.surfaceInfo.currentExtent;
+            {
+                imageBarrier.newLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                imageBarrier.dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+                imageBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            }
+            vkCmdPipelineBarrier2(ctx.frameCommandBuffer[frameIndex], &barriers);
+
+            VkRenderingAttachmentInfo attachmentInfo = {
+                VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO
+            };
+            {
+                attachmentInfo.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                attachmentInfo.loadOp      = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                attachmentInfo.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+                attachmentInfo.imageView   = ctx.frameImageViews[swapchainIndex];
+            }
+
+            VkRenderingInfo renderingInfo = { VK_STRUCTURE_TYPE_RENDERING_INFO };
+            {
+                renderingInfo.colorAttachmentCount = 1u;
+                renderingInfo.pColorAttachments    = &attachmentInfo;
+                renderingInfo.layerCount           = 1u;
+                renderingInfo.renderArea.extent    = ctx.surfaceInfo.currentExtent;
+            }
+            vkCmdBeginRendering(ctx.frameCommandBuffer[frameIndex], &renderingInfo);
+
+            // If the user provided a mutex, lock it here and now (ImGui may do
+            // some internal queue submissions).
+            if (pDispatchQueueMutex)
+                std::lock_guard _(*pDispatchQueueMutex);
+
+            ImGui::Render();
+            ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(),
+                                            ctx.frameCommandBuffer[frameIndex]);
+
+            vkCmdEndRendering(ctx.frameCommandBuffer[frameIndex]);
+
+            {
+                imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                imageBarrier.srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+                imageBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            }
         }
-        vkCmdBeginRendering(ctx.frameCommandBuffer[frameIndex], &renderingInfo);
+#endif
 
-        // If the user provided a mutex, lock it here and now (ImGui may do some
-        // internal queue submissions).
-        if (pDispatchQueueMutex)
-            std::lock_guard _(*pDispatchQueueMutex);
+        if (Internal::IsCapturingSwapchain(ctx))
+        {
+            {
+                imageBarrier.newLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                imageBarrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+                imageBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+            }
+            vkCmdPipelineBarrier2(ctx.frameCommandBuffer[frameIndex], &barriers);
 
-        ImGui::Render();
-        ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), ctx.frameCommandBuffer[frameIndex]);
+            Internal::CaptureSwapchain(ctx, frameIndex);
 
-        vkCmdEndRendering(ctx.frameCommandBuffer[frameIndex]);
+            {
+                imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                imageBarrier.srcAccessMask = VK_ACCESS_2_NONE;
+                imageBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+            }
+        }
 
+        // Nothing to do if neither the UI nor a capture touched the image.
+        if (imageBarrier.oldLayout != VK_IMAGE_LAYOUT_PRESENT_SRC_KHR)
         {
-            imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            imageBarrier.newLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-            imageBarrier.srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
-            imageBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
-            imageBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
-            imageBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT;
+            {
+                imageBarrier.newLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+                imageBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+                imageBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT;
+            }
+            vkCmdPipelineBarrier2(ctx.frameCommandBuffer[frameIndex], &barriers);
         }
-        vkCmdPipelineBarrier2(ctx.frameCommandBuffer[frameIndex], &barriers);
+
+        Internal::EndDynamicResolution(ctx, frameIndex);
 
         // -----------------------
 
         ThrowOnFail(vkEndCommandBuffer(ctx.frameCommandBuffer[frameIndex]));
 
-        const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-
         VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
         {
 
             submitInfo.commandBufferCount   = 1u;
             submitInfo.pCommandBuffers      = &ctx.frameCommandBuffer[frameIndex];
-            submitInfo.waitSemaphoreCount   = 1u;
-            submitInfo.pWaitSemaphores      = &ctx.frameSemaphoreImageAvailable[frameIndex];
-            submitInfo.pWaitDstStageMask    = &waitStage;
+            submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(waitSemaphores.size());
+            submitInfo.pWaitSemaphores      = waitSemaphores.data();
+            submitInfo.pWaitDstStageMask    = waitStages.data();
             submitInfo.signalSemaphoreCount = 1u;
             submitInfo.pSignalSemaphores    = &ctx.frameSemaphoreRenderComplete[frameIndex];
         }
@@ -595,9 +1027,9 @@ void Aule::Dispatch(Context&                      ctx,
 
         VkPresentInfoKHR presentInfo = { VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
         {
-            presentInfo.swapchainCount     = 1u;
-            presentInfo.pSwapchains        = &ctx.swapchain;
-            presentInfo.pImageIndices      = &swapchainIndex;
+            presentInfo.swapchainCount     = static_cast<uint32_t>(presentSwapchains.size());
+            presentInfo.pSwapchains        = presentSwapchains.data();
+            presentInfo.pImageIndices      = presentImageIndices.data();
             presentInfo.waitSemaphoreCount = 1u;
             presentInfo.pWaitSemaphores    = &ctx.frameSemaphoreRenderComplete[frameIndex];
         }
@@ -606,5 +1038,7 @@ void Aule::Dispatch(Context&                      ctx,
         // -----------------------
 
         frameIndex = (frameIndex + 1u) % ctx.frameCommandBuffer.size();
+
+        ctx.frameNumber++;
     }
 }
@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+struct Aule::FrameCapture
+{
+    enum class SlotState
+    {
+        Free,
+        InFlight,
+        Encoding
+    };
+
+    struct Slot
+    {
+        VkBuffer      buffer     = VK_NULL_HANDLE;
+        VmaAllocation allocation = VK_NULL_HANDLE;
+        void*         pMapped    = nullptr;
+        VkDeviceSize  capacity   = 0u;
+        SlotState     state      = SlotState::Free;
+        CaptureResult result     = {};
+    };
+
+    CaptureParams     params;
+    std::string       outputPrefix;
+    std::vector<Slot> slots;
+
+    // Guards slot state and the encode queue, shared with the encoder thread.
+    std::mutex              mutex;
+    std::condition_variable signal;
+    std::deque<uint32_t>    encodeQueue;
+    bool                    exit = false;
+    std::thread             encoder;
+
+    std::atomic<uint64_t> captured = 0u;
+    std::atomic<uint64_t> skipped  = 0u;
+};
+
+// PNG
+// -----------------------
+
+static uint32_t Crc32(uint32_t crc, const uint8_t* pData, size_t size)
+{
+    static const auto kTable = []
+    {
+        std::array<uint32_t, 256u> table = {};
+
+        for (uint32_t i = 0u; i < 256u; i++)
+        {
+            uint32_t c = i;
+
+            for (uint32_t k = 0u; k < 8u; k++)
+                c = (c & 1u) ? 0xEDB88320u ^ (c >> 1u) : c >> 1u;
+
+            table[i] = c;
+        }
+
+        return table;
+    }();
+
+    crc = ~crc;
+
+    for (size_t i = 0u; i < size; i++)
+        crc = kTable[(crc ^ pData[i]) & 0xFFu] ^ (crc >> 8u);
+
+    return ~crc;
+}
+
+static void WriteBigEndian(std::vector<uint8_t>& bytes, uint32_t value)
+{
+    bytes.push_back(static_cast<uint8_t>(value >> 24u));
+    bytes.push_back(static_cast<uint8_t>(value >> 16u));
+    bytes.push_back(static_cast<uint8_t>(value >> 8u));
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+static void WritePNGChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data)
+{
+    std::vector<uint8_t> chunk;
+    chunk.reserve(data.size() + 12u);
+
+    WriteBigEndian(chunk, static_cast<uint32_t>(data.size()));
+    chunk.insert(chunk.end(), type, type + 4u);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+
+    // CRC covers the chunk type and data, not the length.
+    WriteBigEndian(chunk, Crc32(0u, chunk.data() + 4u, chunk.size() - 4u));
+
+    file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+}
+
+// Encoding speed matters far more than file size here, so the image data is
+// emitted as uncompressed (stored) deflate blocks.
+static void WritePNG(const std::string& path, const CaptureResult& capture)
+{
+    const bool isBGRA = capture.format == VK_FORMAT_B8G8R8A8_UNORM ||
+                        capture.format == VK_FORMAT_B8G8R8A8_SRGB;
+
+    const uint32_t width  = capture.extent.width;
+    const uint32_t height = capture.extent.height;
+    const auto*    pTexel = static_cast<const uint8_t*>(capture.pData);
+
+    // Filter byte + RGB texels per scanline.
+    std::vector<uint8_t> scanlines;
+    scanlines.reserve(static_cast<size_t>(height) * (1u + width * 3u));
+
+    for (uint32_t y = 0u; y < height; y++)
+    {
+        scanlines.push_back(0u);
+
+        for (uint32_t x = 0u; x < width; x++, pTexel += 4u)
+        {
+            scanlines.push_back(pTexel[isBGRA ? 2u : 0u]);
+            scanlines.push_back(pTexel[1u]);
+            scanlines.push_back(pTexel[isBGRA ? 0u : 2u]);
+        }
+    }
+
+    std::vector<uint8_t> zlib;
+    zlib.reserve(scanlines.size() + (scanlines.size() / 0xFFFFu + 1u) * 5u + 6u);
+    zlib.push_back(0x78u);
+    zlib.push_back(0x01u);
+
+    uint32_t adlerA = 1u;
+    uint32_t adlerB = 0u;
+
+    for (size_t offset = 0u; offset < scanlines.size(); offset += 0xFFFFu)
+    {
+        const auto blockSize =
+            static_cast<uint16_t>(std::min<size_t>(0xFFFFu, scanlines.size() - offset));
+        const auto blockSizeComplement = static_cast<uint16_t>(~blockSize);
+
+        zlib.push_back(offset + blockSize == scanlines.size() ? 1u : 0u);
+        zlib.push_back(static_cast<uint8_t>(blockSize));
+        zlib.push_back(static_cast<uint8_t>(blockSize >> 8u));
+        zlib.push_back(static_cast<uint8_t>(blockSizeComplement));
+        zlib.push_back(static_cast<uint8_t>(blockSizeComplement >> 8u));
+
+        for (size_t i = offset; i < offset + blockSize; i++)
+        {
+            adlerA = (adlerA + scanlines[i]) % 65521u;
+            adlerB = (adlerB + adlerA) % 65521u;
+        }
+
+        zlib.insert(zlib.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+    }
+
+    WriteBigEndian(zlib, (adlerB << 16u) | adlerA);
+
+    std::vector<uint8_t> header;
+    {
+        WriteBigEndian(header, width);
+        WriteBigEndian(header, height);
+
+        // 8-bit depth, truecolor, deflate, adaptive filtering, no interlace.
+        header.insert(header.end(), { 8u, 2u, 0u, 0u, 0u });
+    }
+
+    std::ofstream file(path, std::ios::binary);
+
+    static const uint8_t kSignature[] = { 0x89u, 'P', 'N', 'G', '\r', '\n', 0x1Au, '\n' };
+    file.write(reinterpret_cast<const char*>(kSignature), sizeof(kSignature));
+
+    WritePNGChunk(file, "IHDR", header);
+    WritePNGChunk(file, "IDAT", zlib);
+    WritePNGChunk(file, "IEND", {});
+}
+
+// Formats WritePNG can encode, 8-bit RGBA or BGRA texels.
+static bool IsPNGFormat(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB: return true;
+        default: return false;
+    }
+}
+
+static void EncodeCapture(const FrameCapture& capture, const CaptureResult& result)
+{
+    if (capture.params.onCapture)
+    {
+        capture.params.onCapture(result);
+        return;
+    }
+
+    const auto path = capture.outputPrefix + std::to_string(result.frameNumber);
+
+    if (capture.params.format == CaptureFormat::PNG && IsPNGFormat(result.format))
+    {
+        WritePNG(path + ".png", result);
+        return;
+    }
+
+    // Fall back to raw for anything PNG can't represent.
+    std::ofstream file(path + ".raw", std::ios::binary);
+    file.write(static_cast<const char*>(result.pData), result.size);
+}
+
+static void EncoderThread(FrameCapture* pCapture)
+{
+    for (;;)
+    {
+        uint32_t slotIndex;
+        {
+            std::unique_lock lock(pCapture->mutex);
+
+            pCapture->signal.wait(lock,
+                                  [&] { return pCapture->exit || !pCapture->encodeQueue.empty(); });
+
+            // Drain everything that is queued before honoring exit.
+            if (pCapture->encodeQueue.empty())
+                return;
+
+            slotIndex = pCapture->encodeQueue.front();
+            pCapture->encodeQueue.pop_front();
+        }
+
+        // Slot is exclusively owned by the encoder while in the Encoding state.
+        auto& slot = pCapture->slots[slotIndex];
+
+        EncodeCapture(*pCapture, slot.result);
+
+        {
+            std::lock_guard _(pCapture->mutex);
+            slot.state = FrameCapture::SlotState::Free;
+        }
+
+        pCapture->captured++;
+    }
+}
+
+// Implementation
+// -----------------------
+
+void Aule::BeginCapture(Context& context, const CaptureParams& params)
+{
+    assert(context.pCapture == nullptr);
+
+    // Swapchain readback relies on the surface supporting transfer source usage.
+    if (params.captureSwapchain)
+        ThrowOnFail(
+            (context.surfaceInfo.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0u);
+
+    auto* pCapture = new FrameCapture();
+    {
+        pCapture->params       = params;
+        pCapture->outputPrefix = params.outputPrefix ? params.outputPrefix : "";
+        pCapture->slots.resize(params.ringSize ? params.ringSize : context.frameImageCount + 2u);
+        pCapture->encoder = std::thread(EncoderThread, pCapture);
+    }
+
+    context.pCapture = pCapture;
+}
+
+void Aule::EndCapture(Context& context)
+{
+    auto* pCapture = context.pCapture;
+
+    if (!pCapture)
+        return;
+
+    // Let every in-flight copy land and hand it to the encoder. Running the
+    // deletion queues early is safe once the device is idle.
+    vkDeviceWaitIdle(context.device);
+
+    for (auto& frameDeletionQueue : context.frameDeletionQueues)
+        Internal::FlushDeletionQueue(frameDeletionQueue);
+
+    {
+        std::lock_guard _(pCapture->mutex);
+        pCapture->exit = true;
+    }
+    pCapture->signal.notify_one();
+    pCapture->encoder.join();
+
+    for (auto& slot : pCapture->slots)
+    {
+        if (slot.buffer != VK_NULL_HANDLE)
+            vmaDestroyBuffer(context.allocator, slot.buffer, slot.allocation);
+    }
+
+    delete pCapture;
+
+    context.pCapture = nullptr;
+}
+
+bool Aule::CaptureImage(Context&      context,
+                        uint32_t      frameIndex,
+                        VkImage       image,
+                        VkImageLayout imageLayout,
+                        VkFormat      format,
+                        VkExtent2D    extent)
+{
+    auto* pCapture = context.pCapture;
+
+    if (!pCapture)
+        return false;
+
+    const auto texelSize = Internal::GetTexelSize(format);
+    ThrowOnFail(texelSize != 0u);
+
+    const VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * texelSize;
+
+    // Find a free readback buffer, otherwise drop this capture.
+    uint32_t slotIndex = UINT32_MAX;
+    {
+        std::lock_guard _(pCapture->mutex);
+
+        for (uint32_t i = 0u; i < pCapture->slots.size(); i++)
+        {
+            if (pCapture->slots[i].state != FrameCapture::SlotState::Free)
+                continue;
+
+            pCapture->slots[i].state = FrameCapture::SlotState::InFlight;
+
+            slotIndex = i;
+
+            break;
+        }
+    }
+
+    if (slotIndex == UINT32_MAX)
+    {
+        pCapture->skipped++;
+        return false;
+    }
+
+    auto& slot = pCapture->slots[slotIndex];
+
+    // (Re)allocate lazily, the slot is not referenced by the GPU or encoder.
+    if (slot.capacity < size)
+    {
+        if (slot.buffer != VK_NULL_HANDLE)
+            vmaDestroyBuffer(context.allocator, slot.buffer, slot.allocation);
+
+        VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        {
+            bufferInfo.size  = size;
+            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        }
+
+        VmaAllocationCreateInfo allocationInfo = {};
+        {
+            allocationInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+            allocationInfo.flags =
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        }
+
+        VmaAllocationInfo allocationResult;
+        ThrowOnFail(vmaCreateBuffer(context.allocator,
+                                    &bufferInfo,
+                                    &allocationInfo,
+                                    &slot.buffer,
+                                    &slot.allocation,
+                                    &allocationResult));
+
+        slot.pMapped  = allocationResult.pMappedData;
+        slot.capacity = size;
+    }
+
+    slot.result = { context.frameNumber, format, extent, slot.pMapped, static_cast<size_t>(size) };
+
+    VkBufferImageCopy copyRegion = {};
+    {
+        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegion.imageSubresource.layerCount = 1u;
+        copyRegion.imageExtent                 = { extent.width, extent.height, 1u };
+    }
+
+    vkCmdCopyImageToBuffer(context.frameCommandBuffer[frameIndex],
+                           image,
+                           imageLayout,
+                           slot.buffer,
+                           1u,
+                           &copyRegion);
+
+    // Make the copy visible to the host once the frame fence signals.
+    VkBufferMemoryBarrier2 bufferBarrier = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2 };
+    {
+        bufferBarrier.buffer        = slot.buffer;
+        bufferBarrier.size          = size;
+        bufferBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+        bufferBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        bufferBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_HOST_BIT;
+        bufferBarrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    }
+
+    VkDependencyInfo barriers = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    {
+        barriers.bufferMemoryBarrierCount = 1u;
+        barriers.pBufferMemoryBarriers    = &bufferBarrier;
+    }
+    vkCmdPipelineBarrier2(context.frameCommandBuffer[frameIndex], &barriers);
+
+    // The frame's deletion queue runs once its fence has signaled, which is
+    // exactly when the copy is complete.
+    context.frameDeletionQueues[frameIndex].push_back(
+        [pCapture, slotIndex, allocator = context.allocator]
+        {
+            auto& slot = pCapture->slots[slotIndex];
+
+            vmaInvalidateAllocation(allocator, slot.allocation, 0u, VK_WHOLE_SIZE);
+
+            {
+                std::lock_guard _(pCapture->mutex);
+
+                slot.state = FrameCapture::SlotState::Encoding;
+                pCapture->encodeQueue.push_back(slotIndex);
+            }
+            pCapture->signal.notify_one();
+        });
+
+    return true;
+}
+
+CaptureStatistics Aule::GetCaptureStatistics(const Context& context)
+{
+    if (!context.pCapture)
+        return {};
+
+    return { context.pCapture->captured.load(), context.pCapture->skipped.load() };
+}
+
+void Aule::Internal::CaptureSwapchain(Context& context, uint32_t frameIndex)
+{
+    CaptureImage(context,
+                 frameIndex,
+                 context.frameImages[context.frameImageIndex],
+                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 context.frameImageFormat,
+                 context.surfaceInfo.currentExtent);
+}
+
+bool Aule::Internal::IsCapturingSwapchain(const Context& context)
+{
+    return context.pCapture && context.pCapture->params.captureSwapchain;
+}
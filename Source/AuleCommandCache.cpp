@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+struct Aule::CommandCache
+{
+    // One secondary command buffer per frame slot, since the recording of a
+    // slot may still be executing while another slot is being recorded.
+    struct Recording
+    {
+        std::vector<VkCommandBuffer> frameCommandBuffer;
+        std::vector<uint64_t>        frameKey;
+        std::vector<bool>            frameValid;
+    };
+
+    // Pools allow individual buffer resets so only dirty recordings are redone.
+    std::vector<VkCommandPool> frameCommandPool;
+
+    std::unordered_map<uint64_t, Recording> recordings;
+};
+
+static CommandCache* CreateCommandCache(const Context& context)
+{
+    auto* pCache = new CommandCache();
+
+    pCache->frameCommandPool.resize(context.frameCommandBuffer.size());
+
+    for (auto& commandPool : pCache->frameCommandPool)
+    {
+        VkCommandPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+        {
+            poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+            poolInfo.queueFamilyIndex = context.selectedQueueFamilyIndex;
+        }
+        ThrowOnFail(vkCreateCommandPool(context.device, &poolInfo, nullptr, &commandPool));
+    }
+
+    return pCache;
+}
+
+void Aule::Internal::DestroyCommandCache(Context& context)
+{
+    auto* pCache = context.pCommandCache;
+
+    if (!pCache)
+        return;
+
+    // Destroying the pools frees every recording allocated from them.
+    for (auto& commandPool : pCache->frameCommandPool)
+        vkDestroyCommandPool(context.device, commandPool, nullptr);
+
+    delete pCache;
+
+    context.pCommandCache = nullptr;
+}
+
+// Implementation
+// -----------------------
+
+void Aule::ExecuteCachedCommands(Context&                                         context,
+                                 uint32_t                                         frameIndex,
+                                 uint64_t                                         id,
+                                 uint64_t                                         key,
+                                 const std::function<void(VkCommandBuffer cmd)>& recordCallback,
+                                 const VkCommandBufferInheritanceRenderingInfo*  pRenderingInfo)
+{
+    if (!context.pCommandCache)
+        context.pCommandCache = CreateCommandCache(context);
+
+    auto* pCache = context.pCommandCache;
+
+    auto& recording = pCache->recordings[id];
+
+    if (recording.frameCommandBuffer.empty())
+    {
+        const auto frameCount = pCache->frameCommandPool.size();
+
+        recording.frameCommandBuffer.resize(frameCount, VK_NULL_HANDLE);
+        recording.frameKey.resize(frameCount, 0u);
+        recording.frameValid.resize(frameCount, false);
+    }
+
+    auto& cmd = recording.frameCommandBuffer[frameIndex];
+
+    if (cmd == VK_NULL_HANDLE)
+    {
+        VkCommandBufferAllocateInfo cmdInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        {
+            cmdInfo.commandPool        = pCache->frameCommandPool[frameIndex];
+            cmdInfo.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            cmdInfo.commandBufferCount = 1u;
+        }
+        ThrowOnFail(vkAllocateCommandBuffers(context.device, &cmdInfo, &cmd));
+    }
+
+    // The previous execution of this slot completed before Dispatch handed the
+    // slot back, so a dirty recording can be reset in place.
+    if (!recording.frameValid[frameIndex] || recording.frameKey[frameIndex] != key)
+    {
+        ThrowOnFail(vkResetCommandBuffer(cmd, 0x0));
+
+        VkCommandBufferInheritanceInfo inheritanceInfo = {
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO
+        };
+        {
+            inheritanceInfo.pNext = pRenderingInfo;
+        }
+
+        VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+        {
+            beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+            if (pRenderingInfo)
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        }
+        ThrowOnFail(vkBeginCommandBuffer(cmd, &beginInfo));
+
+        recordCallback(cmd);
+
+        ThrowOnFail(vkEndCommandBuffer(cmd));
+
+        recording.frameKey[frameIndex]   = key;
+        recording.frameValid[frameIndex] = true;
+    }
+
+    vkCmdExecuteCommands(context.frameCommandBuffer[frameIndex], 1u, &cmd);
+}
+
+void Aule::InvalidateCachedCommands(Context& context, uint64_t id)
+{
+    if (!context.pCommandCache)
+        return;
+
+    auto recording = context.pCommandCache->recordings.find(id);
+
+    if (recording == context.pCommandCache->recordings.end())
+        return;
+
+    std::fill(recording->second.frameValid.begin(), recording->second.frameValid.end(), false);
+}
+
+void Aule::ReleaseCachedCommands(Context& context, uint64_t id)
+{
+    if (!context.pCommandCache)
+        return;
+
+    auto* pCache = context.pCommandCache;
+
+    auto recording = pCache->recordings.find(id);
+
+    if (recording == pCache->recordings.end())
+        return;
+
+    // Each slot's buffer is freed once that slot's last submission completes.
+    for (uint32_t frameIndex = 0u; frameIndex < recording->second.frameCommandBuffer.size();
+         frameIndex++)
+    {
+        auto cmd = recording->second.frameCommandBuffer[frameIndex];
+
+        if (cmd == VK_NULL_HANDLE)
+            continue;
+
+        context.frameDeletionQueues[frameIndex].push_back(
+            [device = context.device, pool = pCache->frameCommandPool[frameIndex], cmd]() mutable
+            { vkFreeCommandBuffers(device, pool, 1u, &cmd); });
+    }
+
+    pCache->recordings.erase(recording);
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+static uint32_t SelectComputeQueueFamily(const std::vector<VkQueueFamilyProperties>& queueFamilies)
+{
+    uint32_t selectedQueueFamilyIndex = UINT32_MAX;
+
+    for (uint32_t queueFamilyIndex = 0u; queueFamilyIndex < queueFamilies.size();
+         queueFamilyIndex++)
+    {
+        const auto queueFlags = queueFamilies[queueFamilyIndex].queueFlags;
+
+        if (!(queueFlags & VK_QUEUE_COMPUTE_BIT))
+            continue;
+
+        // Async compute families don't share the hardware queue with graphics.
+        if (!(queueFlags & VK_QUEUE_GRAPHICS_BIT))
+            return queueFamilyIndex;
+
+        if (selectedQueueFamilyIndex == UINT32_MAX)
+            selectedQueueFamilyIndex = queueFamilyIndex;
+    }
+
+    // Vulkan guarantees a compute capable family on any device with graphics,
+    // but compute-only devices may expose none at all.
+    ThrowOnFail(selectedQueueFamilyIndex != UINT32_MAX);
+
+    return selectedQueueFamilyIndex;
+}
+
+// Implementation
+// -----------------------
+
+ComputeContext Aule::CreateComputeContext(const ComputeParams& params)
+{
+    assert(params.batchesInFlight > 0);
+
+    ComputeContext ctx = {};
+
+    ThrowOnFail(volkInitialize());
+
+    // No presentation, so no instance extensions are needed.
+    ctx.instance = Internal::CreateInstance(params.applicationName, nullptr, 0u);
+
+    Internal::SelectPhysicalDevice(ctx.instance,
+                                   params.deviceHint,
+                                   ctx.selectedPhysicalDevice,
+                                   ctx.selectedPhysicalDeviceProperties,
+                                   ctx.queueFamilyProperties);
+
+    ctx.queueFamilyCount         = static_cast<uint32_t>(ctx.queueFamilyProperties.size());
+    ctx.selectedQueueFamilyIndex = SelectComputeQueueFamily(ctx.queueFamilyProperties);
+
+    std::vector<const char*> extensions;
+    {
+        extensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+    }
+
+    VkPhysicalDeviceFeatures2                features        = {};
+    VkPhysicalDeviceSynchronization2Features featureSync2    = {};
+    VkPhysicalDeviceVulkan12Features         featureVulkan12 = {};
+
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &featureSync2;
+
+    featureSync2.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    featureSync2.synchronization2 = VK_TRUE;
+    featureSync2.pNext            = &featureVulkan12;
+
+    featureVulkan12.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    featureVulkan12.timelineSemaphore = VK_TRUE;
+
+    ctx.device = Internal::CreateDevice(ctx.selectedPhysicalDevice,
+                                        ctx.queueFamilyCount,
+                                        extensions,
+                                        params.deviceExtensions,
+                                        &features,
+                                        ctx.queues,
+                                        ctx.enabledDeviceExtensions);
+
+    ctx.allocator =
+        Internal::CreateAllocator(ctx.instance, ctx.selectedPhysicalDevice, ctx.device);
+
+    // Timeline
+    // ----------------------
+
+    VkSemaphoreTypeCreateInfo semaphoreTypeInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+    {
+        semaphoreTypeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        semaphoreTypeInfo.initialValue  = 0u;
+    }
+
+    VkSemaphoreCreateInfo semaphoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    {
+        semaphoreInfo.pNext = &semaphoreTypeInfo;
+    }
+
+    ThrowOnFail(vkCreateSemaphore(ctx.device, &semaphoreInfo, nullptr, &ctx.timelineSemaphore));
+
+    ctx.submittedValue = 0u;
+
+    // Batches
+    // ----------------------
+
+    ctx.batchCount = params.batchesInFlight;
+    ctx.batchIndex = 0u;
+    ctx.recording  = false;
+
+    ctx.batchCommandPool.resize(ctx.batchCount);
+    ctx.batchCommandBuffer.resize(ctx.batchCount);
+    ctx.batchTimelineValue.resize(ctx.batchCount, 0u);
+    ctx.batchDeletionQueues.resize(ctx.batchCount);
+
+    for (uint32_t batchIndex = 0u; batchIndex < ctx.batchCount; batchIndex++)
+    {
+        VkCommandPoolCreateInfo commandPoolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+        {
+            commandPoolInfo.queueFamilyIndex = ctx.selectedQueueFamilyIndex;
+            commandPoolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        }
+
+        ThrowOnFail(vkCreateCommandPool(ctx.device,
+                                        &commandPoolInfo,
+                                        nullptr,
+                                        &ctx.batchCommandPool[batchIndex]));
+
+        VkCommandBufferAllocateInfo commandBufferInfo = {
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO
+        };
+        {
+            commandBufferInfo.commandPool        = ctx.batchCommandPool[batchIndex];
+            commandBufferInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            commandBufferInfo.commandBufferCount = 1u;
+        }
+
+        ThrowOnFail(vkAllocateCommandBuffers(ctx.device,
+                                             &commandBufferInfo,
+                                             &ctx.batchCommandBuffer[batchIndex]));
+    }
+
+    return ctx;
+}
+
+void Aule::DestroyComputeContext(ComputeContext& context)
+{
+    // A batch that was begun but never submitted holds nothing to wait on.
+    if (context.submittedValue > 0u)
+        WaitComputeBatch(context, context.submittedValue);
+
+    for (auto& batchDeletionQueue : context.batchDeletionQueues)
+        Internal::FlushDeletionQueue(batchDeletionQueue);
+
+    for (auto& commandPool : context.batchCommandPool)
+        vkDestroyCommandPool(context.device, commandPool, nullptr);
+
+    vkDestroySemaphore(context.device, context.timelineSemaphore, nullptr);
+    vmaDestroyAllocator(context.allocator);
+    vkDestroyDevice(context.device, nullptr);
+    vkDestroyInstance(context.instance, nullptr);
+}
+
+VkCommandBuffer Aule::BeginComputeBatch(ComputeContext& context)
+{
+    assert(!context.recording);
+
+    const auto batchIndex = context.batchIndex;
+
+    // Only block once the ring has wrapped around onto a batch still in flight.
+    if (context.batchTimelineValue[batchIndex] > GetCompletedComputeBatch(context))
+        WaitComputeBatch(context, context.batchTimelineValue[batchIndex]);
+
+    Internal::FlushDeletionQueue(context.batchDeletionQueues[batchIndex]);
+
+    ThrowOnFail(vkResetCommandPool(context.device, context.batchCommandPool[batchIndex], 0u));
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO
+    };
+    {
+        commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    }
+
+    auto cmd = context.batchCommandBuffer[batchIndex];
+    ThrowOnFail(vkBeginCommandBuffer(cmd, &commandBufferBeginInfo));
+
+    context.recording = true;
+
+    return cmd;
+}
+
+uint64_t Aule::SubmitComputeBatch(ComputeContext& context)
+{
+    assert(context.recording);
+
+    const auto batchIndex = context.batchIndex;
+    auto       cmd        = context.batchCommandBuffer[batchIndex];
+
+    ThrowOnFail(vkEndCommandBuffer(cmd));
+
+    const uint64_t signalValue = context.submittedValue + 1u;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {
+        VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO
+    };
+    {
+        timelineInfo.signalSemaphoreValueCount = 1u;
+        timelineInfo.pSignalSemaphoreValues    = &signalValue;
+    }
+
+    VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    {
+        submitInfo.pNext                = &timelineInfo;
+        submitInfo.commandBufferCount   = 1u;
+        submitInfo.pCommandBuffers      = &cmd;
+        submitInfo.signalSemaphoreCount = 1u;
+        submitInfo.pSignalSemaphores    = &context.timelineSemaphore;
+    }
+
+    ThrowOnFail(vkQueueSubmit(context.queues[context.selectedQueueFamilyIndex],
+                              1u,
+                              &submitInfo,
+                              VK_NULL_HANDLE));
+
+    context.submittedValue                 = signalValue;
+    context.batchTimelineValue[batchIndex] = signalValue;
+    context.batchIndex                     = (batchIndex + 1u) % context.batchCount;
+    context.recording                      = false;
+
+    return signalValue;
+}
+
+bool Aule::WaitComputeBatch(const ComputeContext& context, uint64_t value, uint64_t timeout)
+{
+    VkSemaphoreWaitInfo waitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    {
+        waitInfo.semaphoreCount = 1u;
+        waitInfo.pSemaphores    = &context.timelineSemaphore;
+        waitInfo.pValues        = &value;
+    }
+
+    auto result = vkWaitSemaphores(context.device, &waitInfo, timeout);
+
+    if (result == VK_TIMEOUT)
+        return false;
+
+    ThrowOnFail(result);
+
+    return true;
+}
+
+bool Aule::IsDeviceExtensionEnabled(const ComputeContext& context, const char* extension)
+{
+    const auto& extensions = context.enabledDeviceExtensions;
+
+    return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+}
+
+uint64_t Aule::GetCompletedComputeBatch(const ComputeContext& context)
+{
+    uint64_t value;
+    ThrowOnFail(vkGetSemaphoreCounterValue(context.device, context.timelineSemaphore, &value));
+
+    return value;
+}
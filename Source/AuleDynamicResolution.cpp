@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+// Fraction of the measured frame time folded into the running average, and the
+// largest change of scale per frame, to keep the resolution from oscillating.
+static constexpr float kFrameTimeSmoothing = 0.1f;
+static constexpr float kMaxScaleStep       = 0.05f;
+
+struct Aule::DynamicResolution
+{
+    DynamicResolutionParams params;
+
+    VkImage       image;
+    VmaAllocation allocation;
+    VkImageView   imageView;
+    VkFormat      format;
+    VkExtent2D    extent;
+
+    // Two timestamps per frame slot, bracketing the frame command buffer.
+    VkQueryPool       queryPool;
+    std::vector<bool> frameTimestampsWritten;
+    uint64_t          timestampMask;
+
+    float      scale;
+    float      gpuFrameTimeMs;
+    VkExtent2D renderExtent;
+
+    // Frame the target was last handed to the callback, enabling mid-frame
+    // only takes effect on the next one.
+    uint64_t beganFrame = UINT64_MAX;
+
+    bool pendingDisable;
+};
+
+static void ReleaseDynamicResolution(Context& context, DynamicResolution* pResolution)
+{
+    vkDestroyQueryPool(context.device, pResolution->queryPool, nullptr);
+    vkDestroyImageView(context.device, pResolution->imageView, nullptr);
+    vmaDestroyImage(context.allocator, pResolution->image, pResolution->allocation);
+
+    delete pResolution;
+}
+
+static void UpdateRenderExtent(const Context& context, DynamicResolution& resolution)
+{
+    const auto& swapchainExtent = context.surfaceInfo.currentExtent;
+
+    resolution.renderExtent.width =
+        std::clamp(static_cast<uint32_t>(swapchainExtent.width * resolution.scale),
+                   1u,
+                   resolution.extent.width);
+    resolution.renderExtent.height =
+        std::clamp(static_cast<uint32_t>(swapchainExtent.height * resolution.scale),
+                   1u,
+                   resolution.extent.height);
+}
+
+void Aule::Internal::BeginDynamicResolution(Context& context, uint32_t frameIndex)
+{
+    auto* pResolution = context.pDynamicResolution;
+
+    if (!pResolution)
+        return;
+
+    // Earlier frames may still be sampling the target.
+    if (pResolution->pendingDisable)
+    {
+        vkQueueWaitIdle(context.queues[context.selectedQueueFamilyIndex]);
+
+        ReleaseDynamicResolution(context, pResolution);
+
+        context.pDynamicResolution = nullptr;
+
+        return;
+    }
+
+    auto cmd = context.frameCommandBuffer[frameIndex];
+
+    // Controller
+    // ---------------------
+
+    // The slot's fence was waited on, so its previous timestamps are final.
+    if (pResolution->frameTimestampsWritten[frameIndex])
+    {
+        uint64_t timestamps[2];
+
+        auto result = vkGetQueryPoolResults(context.device,
+                                            pResolution->queryPool,
+                                            frameIndex * 2u,
+                                            2u,
+                                            sizeof(timestamps),
+                                            timestamps,
+                                            sizeof(uint64_t),
+                                            VK_QUERY_RESULT_64_BIT);
+
+        if (result == VK_SUCCESS)
+        {
+            const auto ticks = (timestamps[1] - timestamps[0]) & pResolution->timestampMask;
+            const auto gpuFrameTimeMs =
+                static_cast<float>(ticks) *
+                context.selectedPhysicalDeviceProperties.limits.timestampPeriod * 1e-6f;
+
+            pResolution->gpuFrameTimeMs =
+                pResolution->gpuFrameTimeMs == 0.0f
+                    ? gpuFrameTimeMs
+                    : std::lerp(pResolution->gpuFrameTimeMs, gpuFrameTimeMs, kFrameTimeSmoothing);
+
+            // Frame time scales roughly with the pixel count, i.e. the square
+            // of the per-axis scale.
+            const auto desiredScale =
+                pResolution->scale * std::sqrt(pResolution->params.targetFrameTimeMs /
+                                               std::max(pResolution->gpuFrameTimeMs, 1e-3f));
+
+            pResolution->scale += std::clamp(
+                desiredScale - pResolution->scale, -kMaxScaleStep, kMaxScaleStep);
+            pResolution->scale = std::clamp(
+                pResolution->scale, pResolution->params.minScale, pResolution->params.maxScale);
+
+            UpdateRenderExtent(context, *pResolution);
+        }
+    }
+
+    // Timed from the stage the swapchain acquire is waited at, so the acquire
+    // and vsync stall isn't counted as GPU time. Streamer and file loader
+    // copies are recorded earlier and stay outside the budget, resolution
+    // can't make them any cheaper.
+    vkCmdResetQueryPool(cmd, pResolution->queryPool, frameIndex * 2u, 2u);
+    vkCmdWriteTimestamp2(cmd,
+                         VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         pResolution->queryPool,
+                         frameIndex * 2u);
+
+    pResolution->frameTimestampsWritten[frameIndex] = true;
+    pResolution->beganFrame                         = context.frameNumber;
+
+    // Target
+    // ---------------------
+
+    // Contents of the previous frame are discarded, the barrier only orders
+    // against the blit that read them.
+    VkImageMemoryBarrier2 imageBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+    {
+        imageBarrier.image                       = pResolution->image;
+        imageBarrier.oldLayout                   = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageBarrier.newLayout                   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        imageBarrier.srcAccessMask               = VK_ACCESS_2_NONE;
+        imageBarrier.dstAccessMask               = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+        imageBarrier.srcStageMask                = VK_PIPELINE_STAGE_2_BLIT_BIT;
+        imageBarrier.dstStageMask                = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+        imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageBarrier.subresourceRange.levelCount = 1u;
+        imageBarrier.subresourceRange.layerCount = 1u;
+    }
+
+    VkDependencyInfo barriers = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    {
+        barriers.imageMemoryBarrierCount = 1u;
+        barriers.pImageMemoryBarriers    = &imageBarrier;
+    }
+    vkCmdPipelineBarrier2(cmd, &barriers);
+}
+
+bool Aule::Internal::ResolveDynamicResolution(Context& context,
+                                              uint32_t frameIndex,
+                                              VkImage  swapchainImage)
+{
+    auto* pResolution = context.pDynamicResolution;
+
+    if (!pResolution || pResolution->beganFrame != context.frameNumber)
+        return false;
+
+    auto cmd = context.frameCommandBuffer[frameIndex];
+
+    VkImageMemoryBarrier2 imageBarriers[2];
+
+    for (auto& imageBarrier : imageBarriers)
+    {
+        imageBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+
+        imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageBarrier.subresourceRange.levelCount = 1u;
+        imageBarrier.subresourceRange.layerCount = 1u;
+        imageBarrier.dstStageMask                = VK_PIPELINE_STAGE_2_BLIT_BIT;
+    }
+
+    {
+        imageBarriers[0].image         = pResolution->image;
+        imageBarriers[0].oldLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        imageBarriers[0].newLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        imageBarriers[0].srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+        imageBarriers[0].dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+        imageBarriers[0].srcStageMask  = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+        // The whole swapchain image is overwritten.
+        imageBarriers[1].image         = swapchainImage;
+        imageBarriers[1].oldLayout     = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageBarriers[1].newLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        imageBarriers[1].srcAccessMask = VK_ACCESS_2_NONE;
+        imageBarriers[1].dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        imageBarriers[1].srcStageMask  = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
+
+    VkDependencyInfo barriers = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    {
+        barriers.imageMemoryBarrierCount = 2u;
+        barriers.pImageMemoryBarriers    = imageBarriers;
+    }
+    vkCmdPipelineBarrier2(cmd, &barriers);
+
+    const auto& srcExtent = pResolution->renderExtent;
+    const auto& dstExtent = context.surfaceInfo.currentExtent;
+
+    VkImageBlit blitRegion = {};
+    {
+        blitRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blitRegion.srcSubresource.layerCount = 1u;
+        blitRegion.srcOffsets[1]             = { static_cast<int32_t>(srcExtent.width),
+                                                 static_cast<int32_t>(srcExtent.height),
+                                                 1 };
+        blitRegion.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blitRegion.dstSubresource.layerCount = 1u;
+        blitRegion.dstOffsets[1]             = { static_cast<int32_t>(dstExtent.width),
+                                                 static_cast<int32_t>(dstExtent.height),
+                                                 1 };
+    }
+
+    vkCmdBlitImage(cmd,
+                   pResolution->image,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   swapchainImage,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   1u,
+                   &blitRegion,
+                   pResolution->params.filter);
+
+    return true;
+}
+
+void Aule::Internal::EndDynamicResolution(Context& context, uint32_t frameIndex)
+{
+    auto* pResolution = context.pDynamicResolution;
+
+    if (!pResolution || pResolution->beganFrame != context.frameNumber)
+        return;
+
+    vkCmdWriteTimestamp2(context.frameCommandBuffer[frameIndex],
+                         VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                         pResolution->queryPool,
+                         frameIndex * 2u + 1u);
+}
+
+void Aule::Internal::DestroyDynamicResolution(Context& context)
+{
+    if (!context.pDynamicResolution)
+        return;
+
+    ReleaseDynamicResolution(context, context.pDynamicResolution);
+
+    context.pDynamicResolution = nullptr;
+}
+
+// Implementation
+// -----------------------
+
+void Aule::EnableDynamicResolution(Context& context, const DynamicResolutionParams& params)
+{
+    assert(params.minScale > 0.0f && params.minScale <= params.maxScale);
+
+    // Re-enabling before a pending disable went through keeps the target.
+    if (context.pDynamicResolution)
+    {
+        context.pDynamicResolution->params         = params;
+        context.pDynamicResolution->pendingDisable = false;
+
+        return;
+    }
+
+    const auto timestampValidBits =
+        context.queueFamilyProperties[context.selectedQueueFamilyIndex].timestampValidBits;
+
+    if (timestampValidBits == 0u)
+        throw std::runtime_error("Graphics queue does not support timestamps.");
+
+    auto* pResolution = new DynamicResolution();
+
+    pResolution->params = params;
+    pResolution->format =
+        params.format != VK_FORMAT_UNDEFINED ? params.format : context.frameImageFormat;
+
+    pResolution->timestampMask =
+        timestampValidBits >= 64u ? UINT64_MAX : (1ull << timestampValidBits) - 1ull;
+
+    const auto& swapchainExtent = context.surfaceInfo.currentExtent;
+
+    pResolution->extent.width =
+        std::max(static_cast<uint32_t>(std::ceil(swapchainExtent.width * params.maxScale)), 1u);
+    pResolution->extent.height =
+        std::max(static_cast<uint32_t>(std::ceil(swapchainExtent.height * params.maxScale)), 1u);
+
+    VkImageCreateInfo imageInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    {
+        imageInfo.imageType   = VK_IMAGE_TYPE_2D;
+        imageInfo.format      = pResolution->format;
+        imageInfo.extent      = { pResolution->extent.width, pResolution->extent.height, 1u };
+        imageInfo.mipLevels   = 1u;
+        imageInfo.arrayLayers = 1u;
+        imageInfo.samples     = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                          VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+
+    VmaAllocationCreateInfo allocationInfo = {};
+    {
+        allocationInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    }
+
+    ThrowOnFail(vmaCreateImage(context.allocator,
+                               &imageInfo,
+                               &allocationInfo,
+                               &pResolution->image,
+                               &pResolution->allocation,
+                               nullptr));
+
+    VkImageViewCreateInfo imageViewInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+    {
+        imageViewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+        imageViewInfo.image                       = pResolution->image;
+        imageViewInfo.format                      = pResolution->format;
+        imageViewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageViewInfo.subresourceRange.levelCount = 1u;
+        imageViewInfo.subresourceRange.layerCount = 1u;
+    }
+    ThrowOnFail(
+        vkCreateImageView(context.device, &imageViewInfo, nullptr, &pResolution->imageView));
+
+    const auto frameCount = static_cast<uint32_t>(context.frameCommandBuffer.size());
+
+    VkQueryPoolCreateInfo queryPoolInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+    {
+        queryPoolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = frameCount * 2u;
+    }
+    ThrowOnFail(
+        vkCreateQueryPool(context.device, &queryPoolInfo, nullptr, &pResolution->queryPool));
+
+    pResolution->frameTimestampsWritten.resize(frameCount, false);
+
+    pResolution->scale = params.maxScale;
+
+    UpdateRenderExtent(context, *pResolution);
+
+    context.pDynamicResolution = pResolution;
+}
+
+void Aule::DisableDynamicResolution(Context& context)
+{
+    if (context.pDynamicResolution)
+        context.pDynamicResolution->pendingDisable = true;
+}
+
+DynamicResolutionTarget Aule::GetDynamicResolutionTarget(const Context& context)
+{
+    const auto* pResolution = context.pDynamicResolution;
+
+    if (!pResolution)
+        return {};
+
+    return { pResolution->image,
+             pResolution->imageView,
+             pResolution->format,
+             pResolution->renderExtent };
+}
+
+DynamicResolutionStatistics Aule::GetDynamicResolutionStatistics(const Context& context)
+{
+    const auto* pResolution = context.pDynamicResolution;
+
+    if (!pResolution)
+        return { 1.0f, 0.0f, context.surfaceInfo.currentExtent };
+
+    return { pResolution->scale, pResolution->gpuFrameTimeMs, pResolution->renderExtent };
+}
@@ -0,0 +1,751 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+struct Aule::FileLoader
+{
+    struct MappedFile
+    {
+        const uint8_t* pData = nullptr;
+        VkDeviceSize   size  = 0u;
+    };
+
+    struct Load
+    {
+        MappedFile   file;
+        VkBuffer     dstBuffer;
+        VkDeviceSize recordedBytes = 0u;
+    };
+
+    // Range of a file mapping imported as a transfer source buffer.
+    struct Import
+    {
+        FileLoad       load;
+        VkBuffer       buffer;
+        VkDeviceMemory memory;
+        VkDeviceSize   size;
+        VkDeviceSize   dstOffset;
+        VkDeviceSize   copiedBytes;
+    };
+
+    // A range of a file mapping the I/O thread imports, or copies into a
+    // staging buffer.
+    struct Chunk
+    {
+        FileLoad       load;
+        const uint8_t* pSource;
+        VkDeviceSize   size;
+        VkDeviceSize   dstOffset;
+        uint32_t       stagingIndex;
+    };
+
+    struct StagingBuffer
+    {
+        VkBuffer      buffer;
+        VmaAllocation allocation;
+        void*         pData;
+    };
+
+    FileLoaderParams params;
+    VkDevice         device;
+    VmaAllocator     allocator;
+
+    // Zero if host memory can't be imported.
+    VkDeviceSize importAlignment = 0u;
+    VkDeviceSize maxImportSize   = 0u;
+
+    // Loads are erased once complete, so any id below `nextLoad` that isn't
+    // found has completed.
+    std::unordered_map<FileLoad, Load> loads;
+    FileLoad                           nextLoad = 0u;
+
+    // Imports ready to be copied from, in order.
+    std::deque<Import> imports;
+
+    uint64_t importedBytes = 0u;
+    uint64_t stagedBytes   = 0u;
+
+    // Staging pool, fixed once the loader is created.
+    std::vector<StagingBuffer> staging;
+
+    // I/O thread.
+    std::mutex              mutex;
+    std::condition_variable signal;
+    std::deque<Chunk>       importQueue;
+    std::deque<Import>      completedImports;
+    std::deque<Chunk>       chunkQueue;
+    std::deque<Chunk>       completedChunks;
+    std::vector<uint32_t>   freeStaging;
+    bool                    exit = false;
+    std::thread             worker;
+};
+
+// Files are mapped read-only, so the mapping only ever holds page cache pages.
+// Drivers that refuse to import read-only pages get the range staged instead.
+static bool MapFile(const char* path, FileLoader::MappedFile& file)
+{
+#ifdef _WIN32
+    auto handle = CreateFileA(path,
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size))
+    {
+        CloseHandle(handle);
+        return false;
+    }
+
+    file.size = static_cast<VkDeviceSize>(size.QuadPart);
+
+    if (file.size == 0u)
+    {
+        CloseHandle(handle);
+        return true;
+    }
+
+    auto mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+
+    // The view keeps the file open.
+    CloseHandle(handle);
+
+    if (!mapping)
+        return false;
+
+    file.pData = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0u, 0u, 0u));
+
+    CloseHandle(mapping);
+
+    return file.pData != nullptr;
+#else
+    auto descriptor = open(path, O_RDONLY);
+
+    if (descriptor < 0)
+        return false;
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0)
+    {
+        close(descriptor);
+        return false;
+    }
+
+    file.size = static_cast<VkDeviceSize>(status.st_size);
+
+    if (file.size == 0u)
+    {
+        close(descriptor);
+        return true;
+    }
+
+    auto pData = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    // The mapping keeps the file open.
+    close(descriptor);
+
+    if (pData == MAP_FAILED)
+        return false;
+
+    // Staged ranges are read front to back.
+    madvise(pData, file.size, MADV_SEQUENTIAL);
+
+    file.pData = static_cast<const uint8_t*>(pData);
+
+    return true;
+#endif
+}
+
+static void UnmapFile(FileLoader::MappedFile& file)
+{
+    if (!file.pData)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(file.pData);
+#else
+    munmap(const_cast<uint8_t*>(file.pData), file.size);
+#endif
+
+    file = {};
+}
+
+// Wraps host memory in a transfer source buffer, pinning its pages. False if
+// the driver can't import it, in which case the range is staged instead.
+static bool ImportHostMemory(VkDevice        device,
+                             const void*     pHost,
+                             VkDeviceSize    size,
+                             VkBuffer&       buffer,
+                             VkDeviceMemory& memory)
+{
+    VkMemoryHostPointerPropertiesEXT hostPointerProperties = {
+        VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT
+    };
+
+    if (vkGetMemoryHostPointerPropertiesEXT(device,
+                                            VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+                                            pHost,
+                                            &hostPointerProperties) != VK_SUCCESS)
+        return false;
+
+    VkExternalMemoryBufferCreateInfo externalBufferInfo = {
+        VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO
+    };
+    {
+        externalBufferInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+    }
+
+    VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    {
+        bufferInfo.pNext = &externalBufferInfo;
+        bufferInfo.size  = size;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    }
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
+        return false;
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memoryRequirements);
+
+    const auto memoryTypeBits =
+        memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits;
+
+    if (memoryTypeBits == 0u || memoryRequirements.size > size)
+    {
+        vkDestroyBuffer(device, buffer, nullptr);
+        return false;
+    }
+
+    uint32_t memoryTypeIndex = 0u;
+
+    while (!(memoryTypeBits & (1u << memoryTypeIndex)))
+        memoryTypeIndex++;
+
+    VkImportMemoryHostPointerInfoEXT importInfo = {
+        VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT
+    };
+    {
+        importInfo.handleType   = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+        importInfo.pHostPointer = const_cast<void*>(pHost);
+    }
+
+    VkMemoryAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    {
+        allocateInfo.pNext           = &importInfo;
+        allocateInfo.allocationSize  = size;
+        allocateInfo.memoryTypeIndex = memoryTypeIndex;
+    }
+
+    if (vkAllocateMemory(device, &allocateInfo, nullptr, &memory) != VK_SUCCESS)
+    {
+        vkDestroyBuffer(device, buffer, nullptr);
+        return false;
+    }
+
+    if (vkBindBufferMemory(device, buffer, memory, 0u) != VK_SUCCESS)
+    {
+        vkFreeMemory(device, memory, nullptr);
+        vkDestroyBuffer(device, buffer, nullptr);
+        return false;
+    }
+
+    return true;
+}
+
+// Splits a range of a mapping into staging chunks. The loader mutex must be
+// held.
+static void QueueStagedRange(FileLoader&    loader,
+                             FileLoad       loadId,
+                             const uint8_t* pSource,
+                             VkDeviceSize   size,
+                             VkDeviceSize   dstOffset)
+{
+    const auto chunkSize = loader.params.stagingChunkSize;
+
+    for (VkDeviceSize offset = 0u; offset < size; offset += chunkSize)
+    {
+        FileLoader::Chunk chunk = {};
+        {
+            chunk.load      = loadId;
+            chunk.pSource   = pSource + offset;
+            chunk.size      = std::min(chunkSize, size - offset);
+            chunk.dstOffset = dstOffset + offset;
+        }
+
+        loader.chunkQueue.push_back(chunk);
+    }
+}
+
+static void WorkerThread(FileLoader* pLoader)
+{
+    for (;;)
+    {
+        FileLoader::Chunk chunk;
+        bool              import;
+        {
+            std::unique_lock lock(pLoader->mutex);
+
+            pLoader->signal.wait(lock,
+                                 [&]
+                                 {
+                                     return pLoader->exit || !pLoader->importQueue.empty() ||
+                                            (!pLoader->chunkQueue.empty() &&
+                                             !pLoader->freeStaging.empty());
+                                 });
+
+            if (pLoader->exit)
+                return;
+
+            import = !pLoader->importQueue.empty();
+
+            if (import)
+            {
+                chunk = pLoader->importQueue.front();
+                pLoader->importQueue.pop_front();
+            }
+            else
+            {
+                chunk = pLoader->chunkQueue.front();
+                pLoader->chunkQueue.pop_front();
+
+                chunk.stagingIndex = pLoader->freeStaging.back();
+                pLoader->freeStaging.pop_back();
+            }
+        }
+
+        if (import)
+        {
+            FileLoader::Import result = {};
+            {
+                result.load      = chunk.load;
+                result.size      = chunk.size;
+                result.dstOffset = chunk.dstOffset;
+            }
+
+            // Pinning faults the pages in, which is why imports run here.
+            const bool imported = ImportHostMemory(
+                pLoader->device, chunk.pSource, chunk.size, result.buffer, result.memory);
+
+            std::lock_guard _(pLoader->mutex);
+
+            if (imported)
+                pLoader->completedImports.push_back(result);
+            else
+                QueueStagedRange(*pLoader, chunk.load, chunk.pSource, chunk.size, chunk.dstOffset);
+
+            continue;
+        }
+
+        const auto& staging = pLoader->staging[chunk.stagingIndex];
+
+        // Page faults on the mapping do the actual reading.
+        memcpy(staging.pData, chunk.pSource, chunk.size);
+
+        vmaFlushAllocation(pLoader->allocator, staging.allocation, 0u, chunk.size);
+
+        std::lock_guard _(pLoader->mutex);
+        pLoader->completedChunks.push_back(chunk);
+    }
+}
+
+// Unmaps the file once the frame holding the load's last copy completes.
+static void RecordLoadBytes(Context&     ctx,
+                            FileLoader&  loader,
+                            uint32_t     frameIndex,
+                            FileLoad     loadId,
+                            VkDeviceSize size)
+{
+    auto& load = loader.loads[loadId];
+
+    load.recordedBytes += size;
+
+    if (load.recordedBytes < load.file.size)
+        return;
+
+    ctx.frameDeletionQueues[frameIndex].push_back(
+        [pLoader = &loader, loadId]
+        {
+            auto load = pLoader->loads.find(loadId);
+
+            UnmapFile(load->second.file);
+
+            pLoader->loads.erase(load);
+        });
+}
+
+// Implementation
+// -----------------------
+
+void Aule::CreateFileLoader(Context& context, const FileLoaderParams& params)
+{
+    assert(context.pFileLoader == nullptr);
+    assert(params.stagingChunkSize > 0u);
+    assert(params.stagingChunkCount > 0u);
+    assert(params.maxCopyBytesPerFrame > 0u);
+
+    auto* pLoader = new FileLoader();
+
+    pLoader->params    = params;
+    pLoader->device    = context.device;
+    pLoader->allocator = context.allocator;
+
+    if (IsDeviceExtensionEnabled(context, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME))
+    {
+        VkPhysicalDeviceExternalMemoryHostPropertiesEXT hostProperties = {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT
+        };
+
+        VkPhysicalDeviceMaintenance3Properties maintenance3Properties = {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_3_PROPERTIES
+        };
+        {
+            maintenance3Properties.pNext = &hostProperties;
+        }
+
+        VkPhysicalDeviceProperties2 properties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+        {
+            properties.pNext = &maintenance3Properties;
+        }
+
+        vkGetPhysicalDeviceProperties2(context.selectedPhysicalDevice, &properties);
+
+        const auto alignment = hostProperties.minImportedHostPointerAlignment;
+
+        // Imports are split to bound how much a single one pins, and to fit
+        // in a single allocation.
+        const auto maxImportSize =
+            std::min(params.maxImportSize, maintenance3Properties.maxMemoryAllocationSize);
+
+        pLoader->importAlignment = alignment;
+        pLoader->maxImportSize   = std::max(maxImportSize - maxImportSize % alignment, alignment);
+    }
+
+    pLoader->staging.resize(params.stagingChunkCount);
+
+    for (uint32_t stagingIndex = 0u; stagingIndex < params.stagingChunkCount; stagingIndex++)
+    {
+        VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        {
+            bufferInfo.size  = params.stagingChunkSize;
+            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        }
+
+        VmaAllocationCreateInfo allocationInfo = {};
+        {
+            allocationInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+            allocationInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                                   VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        }
+
+        auto& staging = pLoader->staging[stagingIndex];
+
+        VmaAllocationInfo allocationResult;
+        ThrowOnFail(vmaCreateBuffer(context.allocator,
+                                    &bufferInfo,
+                                    &allocationInfo,
+                                    &staging.buffer,
+                                    &staging.allocation,
+                                    &allocationResult));
+
+        staging.pData = allocationResult.pMappedData;
+
+        pLoader->freeStaging.push_back(stagingIndex);
+    }
+
+    pLoader->worker = std::thread(WorkerThread, pLoader);
+
+    context.pFileLoader = pLoader;
+}
+
+FileLoad Aule::LoadFileToBuffer(Context&     context,
+                                const char*  path,
+                                VkBuffer     dstBuffer,
+                                VkDeviceSize dstOffset)
+{
+    auto* pLoader = context.pFileLoader;
+
+    assert(pLoader != nullptr);
+
+    const auto loadId = pLoader->nextLoad++;
+
+    FileLoader::Load load = {};
+    {
+        load.dstBuffer = dstBuffer;
+    }
+
+    if (!MapFile(path, load.file))
+        throw std::runtime_error(std::string("Failed to map file ") + path + ".");
+
+    // Nothing to copy, the load is complete right away.
+    if (load.file.size == 0u)
+        return loadId;
+
+    const auto& file = load.file;
+
+    {
+        std::lock_guard _(pLoader->mutex);
+
+        VkDeviceSize importSize = 0u;
+
+        const auto alignment = pLoader->importAlignment;
+
+        // Only whole multiples of the alignment can be imported, the tail is
+        // staged. The I/O thread stages any slice the driver refuses.
+        if (alignment != 0u && reinterpret_cast<uintptr_t>(file.pData) % alignment == 0u)
+            importSize = file.size - file.size % alignment;
+
+        for (VkDeviceSize offset = 0u; offset < importSize; offset += pLoader->maxImportSize)
+        {
+            FileLoader::Chunk slice = {};
+            {
+                slice.load      = loadId;
+                slice.pSource   = file.pData + offset;
+                slice.size      = std::min(importSize - offset, pLoader->maxImportSize);
+                slice.dstOffset = dstOffset + offset;
+            }
+
+            pLoader->importQueue.push_back(slice);
+        }
+
+        QueueStagedRange(*pLoader,
+                         loadId,
+                         file.pData + importSize,
+                         file.size - importSize,
+                         dstOffset + importSize);
+    }
+    pLoader->signal.notify_one();
+
+    pLoader->loads.emplace(loadId, load);
+
+    return loadId;
+}
+
+bool Aule::IsFileLoadComplete(const Context& context, FileLoad load)
+{
+    const auto* pLoader = context.pFileLoader;
+
+    return load < pLoader->nextLoad && !pLoader->loads.contains(load);
+}
+
+FileLoaderStatistics Aule::GetFileLoaderStatistics(const Context& context)
+{
+    if (!context.pFileLoader)
+        return {};
+
+    return { context.pFileLoader->importedBytes,
+             context.pFileLoader->stagedBytes,
+             static_cast<uint32_t>(context.pFileLoader->loads.size()) };
+}
+
+void Aule::Internal::UpdateFileLoader(Context& context, uint32_t frameIndex)
+{
+    auto* pLoader = context.pFileLoader;
+
+    if (!pLoader)
+        return;
+
+    auto cmd = context.frameCommandBuffer[frameIndex];
+
+    auto budget = pLoader->params.maxCopyBytesPerFrame;
+
+    bool recorded = false;
+
+    // Staged chunks first, to hand their buffers back to the I/O thread.
+    // -----------------------
+
+    std::deque<FileLoader::Chunk> completedChunks;
+    {
+        std::lock_guard _(pLoader->mutex);
+        completedChunks.swap(pLoader->completedChunks);
+
+        pLoader->imports.insert(pLoader->imports.end(),
+                                pLoader->completedImports.begin(),
+                                pLoader->completedImports.end());
+        pLoader->completedImports.clear();
+    }
+
+    while (!completedChunks.empty() && (!recorded || completedChunks.front().size <= budget))
+    {
+        const auto chunk = completedChunks.front();
+        completedChunks.pop_front();
+
+        const auto& load = pLoader->loads[chunk.load];
+
+        VkBufferCopy copyRegion = {};
+        {
+            copyRegion.dstOffset = chunk.dstOffset;
+            copyRegion.size      = chunk.size;
+        }
+        vkCmdCopyBuffer(cmd,
+                        pLoader->staging[chunk.stagingIndex].buffer,
+                        load.dstBuffer,
+                        1u,
+                        &copyRegion);
+
+        // Staging is read by this frame's copy at most.
+        context.frameDeletionQueues[frameIndex].push_back(
+            [pLoader, stagingIndex = chunk.stagingIndex]
+            {
+                {
+                    std::lock_guard _(pLoader->mutex);
+                    pLoader->freeStaging.push_back(stagingIndex);
+                }
+                pLoader->signal.notify_one();
+            });
+
+        RecordLoadBytes(context, *pLoader, frameIndex, chunk.load, chunk.size);
+
+        pLoader->stagedBytes += chunk.size;
+
+        budget -= std::min(budget, chunk.size);
+        recorded = true;
+    }
+
+    // Over budget, keep the rest for the next frame in order.
+    if (!completedChunks.empty())
+    {
+        std::lock_guard _(pLoader->mutex);
+        pLoader->completedChunks.insert(pLoader->completedChunks.begin(),
+                                        completedChunks.begin(),
+                                        completedChunks.end());
+    }
+
+    // Imported mappings, sliced to the budget.
+    // -----------------------
+
+    while (!pLoader->imports.empty() && budget > 0u)
+    {
+        auto& import = pLoader->imports.front();
+
+        const auto& load = pLoader->loads[import.load];
+
+        VkBufferCopy copyRegion = {};
+        {
+            copyRegion.srcOffset = import.copiedBytes;
+            copyRegion.dstOffset = import.dstOffset + import.copiedBytes;
+            copyRegion.size      = std::min(import.size - import.copiedBytes, budget);
+        }
+        vkCmdCopyBuffer(cmd, import.buffer, load.dstBuffer, 1u, &copyRegion);
+
+        pLoader->importedBytes += copyRegion.size;
+
+        import.copiedBytes += copyRegion.size;
+
+        budget -= copyRegion.size;
+        recorded = true;
+
+        const auto importLoad = import.load;
+
+        if (import.copiedBytes == import.size)
+        {
+            // Released ahead of the unmap the last copy of the load queues.
+            context.frameDeletionQueues[frameIndex].push_back(
+                [device = context.device, buffer = import.buffer, memory = import.memory]
+                {
+                    vkDestroyBuffer(device, buffer, nullptr);
+                    vkFreeMemory(device, memory, nullptr);
+                });
+
+            pLoader->imports.pop_front();
+        }
+
+        RecordLoadBytes(context, *pLoader, frameIndex, importLoad, copyRegion.size);
+    }
+
+    if (!recorded)
+        return;
+
+    // Make the uploads visible to the rest of the frame.
+    VkMemoryBarrier2 memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+    {
+        memoryBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+        memoryBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+    }
+
+    VkDependencyInfo barriers = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    {
+        barriers.memoryBarrierCount = 1u;
+        barriers.pMemoryBarriers    = &memoryBarrier;
+    }
+    vkCmdPipelineBarrier2(cmd, &barriers);
+}
+
+void Aule::Internal::DestroyFileLoader(Context& context)
+{
+    auto* pLoader = context.pFileLoader;
+
+    if (!pLoader)
+        return;
+
+    {
+        std::lock_guard _(pLoader->mutex);
+        pLoader->exit = true;
+    }
+    pLoader->signal.notify_one();
+    pLoader->worker.join();
+
+    // Imports have to go before the mappings they wrap.
+    for (auto* pImports : { &pLoader->imports, &pLoader->completedImports })
+    {
+        for (const auto& import : *pImports)
+        {
+            vkDestroyBuffer(context.device, import.buffer, nullptr);
+            vkFreeMemory(context.device, import.memory, nullptr);
+        }
+    }
+
+    for (auto& [loadId, load] : pLoader->loads)
+        UnmapFile(load.file);
+
+    for (const auto& staging : pLoader->staging)
+        vmaDestroyBuffer(context.allocator, staging.buffer, staging.allocation);
+
+    delete pLoader;
+
+    context.pFileLoader = nullptr;
+}
@@ -0,0 +1,556 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+// SPIR-V generated from Shaders/AuleCulling.comp at build time.
+static const uint32_t kCullingFrustumSpirv[] = {
+#include "AuleCullingFrustum.inc"
+};
+
+static const uint32_t kCullingOcclusionSpirv[] = {
+#include "AuleCullingOcclusion.inc"
+};
+
+static constexpr uint32_t kCullingGroupSize = 64u;
+
+// Mirrors the std140 `Constants` block of the culling shader.
+struct CullingConstants
+{
+    glm::mat4 previousViewProjection;
+    glm::vec4 frustumPlanes[6];
+    glm::vec2 depthPyramidSize;
+    uint32_t  depthPyramidMipCount;
+    uint32_t  instanceCount;
+};
+
+// Mirrors the `Counters` block of the culling shader.
+struct CullingCounters
+{
+    uint32_t drawCount;
+    uint32_t frustumCulled;
+    uint32_t occlusionCulled;
+};
+
+struct Aule::GpuCulling
+{
+    // Draws of a frame slot may still be consumed while the next slot culls.
+    struct Frame
+    {
+        VkBuffer      drawBuffer;
+        VmaAllocation drawAllocation;
+
+        VkBuffer      counterBuffer;
+        VmaAllocation counterAllocation;
+
+        VkBuffer      constantBuffer;
+        VmaAllocation constantAllocation;
+        void*         pConstants;
+
+        VkBuffer      readbackBuffer;
+        VmaAllocation readbackAllocation;
+        void*         pReadback;
+
+        VkDescriptorSet descriptorSet;
+
+        // Frame number of the last CullInstances on this slot.
+        uint64_t culledFrame = UINT64_MAX;
+    };
+
+    GpuCullingParams params;
+
+    VkDescriptorSetLayout descriptorSetLayout;
+    VkDescriptorPool      descriptorPool;
+    VkPipelineLayout      pipelineLayout;
+    VkPipeline            pipelineFrustum;
+    VkPipeline            pipelineOcclusion;
+    VkSampler             depthPyramidSampler;
+
+    std::vector<Frame> frames;
+
+    GpuCullingStatistics statistics = {};
+};
+
+static VkPipeline CreateCullingPipeline(const Context&   context,
+                                        VkPipelineLayout pipelineLayout,
+                                        const uint32_t*  pSpirv,
+                                        size_t           spirvSize)
+{
+    VkShaderModuleCreateInfo moduleInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+    {
+        moduleInfo.codeSize = spirvSize;
+        moduleInfo.pCode    = pSpirv;
+    }
+
+    VkShaderModule shaderModule;
+    ThrowOnFail(vkCreateShaderModule(context.device, &moduleInfo, nullptr, &shaderModule));
+
+    VkComputePipelineCreateInfo pipelineInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    {
+        pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = shaderModule;
+        pipelineInfo.stage.pName  = "main";
+        pipelineInfo.layout       = pipelineLayout;
+    }
+
+    VkPipeline pipeline;
+    ThrowOnFail(vkCreateComputePipelines(
+        context.device, VK_NULL_HANDLE, 1u, &pipelineInfo, nullptr, &pipeline));
+
+    vkDestroyShaderModule(context.device, shaderModule, nullptr);
+
+    return pipeline;
+}
+
+static void CreateCullingBuffer(const Context&     context,
+                                VkDeviceSize       size,
+                                VkBufferUsageFlags usage,
+                                bool               hostAccess,
+                                VkBuffer&          buffer,
+                                VmaAllocation&     allocation,
+                                void**             ppMapped)
+{
+    VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    {
+        bufferInfo.size  = size;
+        bufferInfo.usage = usage;
+    }
+
+    VmaAllocationCreateInfo allocationInfo = {};
+    {
+        allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+        if (hostAccess)
+        {
+            allocationInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+            allocationInfo.flags =
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        }
+    }
+
+    VmaAllocationInfo allocationResult;
+    ThrowOnFail(vmaCreateBuffer(context.allocator,
+                                &bufferInfo,
+                                &allocationInfo,
+                                &buffer,
+                                &allocation,
+                                &allocationResult));
+
+    if (ppMapped)
+        *ppMapped = allocationResult.pMappedData;
+}
+
+// Normalized planes of the view frustum (left, right, bottom, top, near, far)
+// for a [0, 1] clip space depth range.
+static void ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 (&planes)[6])
+{
+    auto Row = [&](int row)
+    {
+        return glm::vec4(viewProjection[0][row],
+                         viewProjection[1][row],
+                         viewProjection[2][row],
+                         viewProjection[3][row]);
+    };
+
+    planes[0] = Row(3) + Row(0);
+    planes[1] = Row(3) - Row(0);
+    planes[2] = Row(3) + Row(1);
+    planes[3] = Row(3) - Row(1);
+    planes[4] = Row(2);
+    planes[5] = Row(3) - Row(2);
+
+    for (auto& plane : planes)
+        plane /= glm::length(glm::vec3(plane));
+}
+
+void Aule::Internal::DestroyGpuCulling(Context& context)
+{
+    auto* pCulling = context.pGpuCulling;
+
+    if (!pCulling)
+        return;
+
+    for (auto& frame : pCulling->frames)
+    {
+        vmaDestroyBuffer(context.allocator, frame.drawBuffer, frame.drawAllocation);
+        vmaDestroyBuffer(context.allocator, frame.counterBuffer, frame.counterAllocation);
+        vmaDestroyBuffer(context.allocator, frame.constantBuffer, frame.constantAllocation);
+        vmaDestroyBuffer(context.allocator, frame.readbackBuffer, frame.readbackAllocation);
+    }
+
+    vkDestroyPipeline(context.device, pCulling->pipelineFrustum, nullptr);
+    vkDestroyPipeline(context.device, pCulling->pipelineOcclusion, nullptr);
+    vkDestroyPipelineLayout(context.device, pCulling->pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(context.device, pCulling->descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(context.device, pCulling->descriptorSetLayout, nullptr);
+    vkDestroySampler(context.device, pCulling->depthPyramidSampler, nullptr);
+
+    delete pCulling;
+
+    context.pGpuCulling = nullptr;
+}
+
+// Implementation
+// -----------------------
+
+void Aule::CreateGpuCulling(Context& context, const GpuCullingParams& params)
+{
+    assert(context.pGpuCulling == nullptr);
+
+    // CreateContext enables these whenever the device supports them.
+    VkPhysicalDeviceVulkan12Features supportedVulkan12 = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES
+    };
+
+    VkPhysicalDeviceFeatures2 supportedFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+    {
+        supportedFeatures.pNext = &supportedVulkan12;
+    }
+    vkGetPhysicalDeviceFeatures2(context.selectedPhysicalDevice, &supportedFeatures);
+
+    if (!supportedVulkan12.drawIndirectCount || !supportedFeatures.features.multiDrawIndirect ||
+        !supportedFeatures.features.drawIndirectFirstInstance)
+    {
+        throw std::runtime_error("GPU culling requires the drawIndirectCount, multiDrawIndirect "
+                                 "and drawIndirectFirstInstance device features.");
+    }
+
+    auto* pCulling = new GpuCulling();
+
+    pCulling->params = params;
+
+    const auto frameCount = static_cast<uint32_t>(context.frameCommandBuffer.size());
+
+    // Layout
+    // ---------------------
+
+    VkDescriptorSetLayoutBinding bindings[7] = {};
+
+    for (uint32_t binding = 0u; binding < 7u; binding++)
+    {
+        bindings[binding].binding         = binding;
+        bindings[binding].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[binding].descriptorCount = 1u;
+        bindings[binding].stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    bindings[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[6].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO
+    };
+    {
+        setLayoutInfo.bindingCount = 7u;
+        setLayoutInfo.pBindings    = bindings;
+    }
+    ThrowOnFail(vkCreateDescriptorSetLayout(
+        context.device, &setLayoutInfo, nullptr, &pCulling->descriptorSetLayout));
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
+        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO
+    };
+    {
+        pipelineLayoutInfo.setLayoutCount = 1u;
+        pipelineLayoutInfo.pSetLayouts    = &pCulling->descriptorSetLayout;
+    }
+    ThrowOnFail(vkCreatePipelineLayout(
+        context.device, &pipelineLayoutInfo, nullptr, &pCulling->pipelineLayout));
+
+    // The frustum variant never reads the depth pyramid binding, so it may be
+    // left unwritten when occlusion culling is off.
+    pCulling->pipelineFrustum   = CreateCullingPipeline(context,
+                                                      pCulling->pipelineLayout,
+                                                      kCullingFrustumSpirv,
+                                                      sizeof(kCullingFrustumSpirv));
+    pCulling->pipelineOcclusion = CreateCullingPipeline(context,
+                                                        pCulling->pipelineLayout,
+                                                        kCullingOcclusionSpirv,
+                                                        sizeof(kCullingOcclusionSpirv));
+
+    VkSamplerCreateInfo samplerInfo = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
+    {
+        samplerInfo.magFilter    = VK_FILTER_NEAREST;
+        samplerInfo.minFilter    = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+    }
+    ThrowOnFail(
+        vkCreateSampler(context.device, &samplerInfo, nullptr, &pCulling->depthPyramidSampler));
+
+    // Descriptors
+    // ---------------------
+
+    VkDescriptorPoolSize poolSizes[] = {
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5u * frameCount },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, frameCount },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frameCount },
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    {
+        poolInfo.maxSets       = frameCount;
+        poolInfo.poolSizeCount = 3u;
+        poolInfo.pPoolSizes    = poolSizes;
+    }
+    ThrowOnFail(
+        vkCreateDescriptorPool(context.device, &poolInfo, nullptr, &pCulling->descriptorPool));
+
+    // Frames
+    // ---------------------
+
+    pCulling->frames.resize(frameCount);
+
+    for (auto& frame : pCulling->frames)
+    {
+        CreateCullingBuffer(context,
+                            sizeof(VkDrawIndexedIndirectCommand) * params.maxInstances,
+                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                            false,
+                            frame.drawBuffer,
+                            frame.drawAllocation,
+                            nullptr);
+
+        CreateCullingBuffer(context,
+                            sizeof(CullingCounters),
+                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                            false,
+                            frame.counterBuffer,
+                            frame.counterAllocation,
+                            nullptr);
+
+        CreateCullingBuffer(context,
+                            sizeof(CullingConstants),
+                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                            true,
+                            frame.constantBuffer,
+                            frame.constantAllocation,
+                            &frame.pConstants);
+
+        CreateCullingBuffer(context,
+                            sizeof(CullingCounters),
+                            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                            true,
+                            frame.readbackBuffer,
+                            frame.readbackAllocation,
+                            &frame.pReadback);
+
+        VkDescriptorSetAllocateInfo setInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        {
+            setInfo.descriptorPool     = pCulling->descriptorPool;
+            setInfo.descriptorSetCount = 1u;
+            setInfo.pSetLayouts        = &pCulling->descriptorSetLayout;
+        }
+        ThrowOnFail(vkAllocateDescriptorSets(context.device, &setInfo, &frame.descriptorSet));
+    }
+
+    context.pGpuCulling = pCulling;
+}
+
+void Aule::CullInstances(Context& context, uint32_t frameIndex, const GpuCullingInput& input)
+{
+    auto* pCulling = context.pGpuCulling;
+
+    assert(pCulling != nullptr);
+    assert(input.instanceCount <= pCulling->params.maxInstances);
+
+    auto& frame = pCulling->frames[frameIndex];
+    auto  cmd   = context.frameCommandBuffer[frameIndex];
+
+    assert(frame.culledFrame != context.frameNumber);
+
+    const bool occlusion = input.depthPyramid != VK_NULL_HANDLE;
+
+    // The slot's previous frame completed, its constants and descriptors can
+    // be overwritten in place.
+    CullingConstants constants = {};
+    {
+        ExtractFrustumPlanes(input.viewProjection, constants.frustumPlanes);
+
+        constants.previousViewProjection = input.previousViewProjection;
+        constants.depthPyramidSize       = glm::vec2(input.depthPyramidExtent.width,
+                                               input.depthPyramidExtent.height);
+        constants.depthPyramidMipCount   = input.depthPyramidMipCount;
+        constants.instanceCount          = input.instanceCount;
+    }
+
+    memcpy(frame.pConstants, &constants, sizeof(CullingConstants));
+    ThrowOnFail(vmaFlushAllocation(
+        context.allocator, frame.constantAllocation, 0u, sizeof(CullingConstants)));
+
+    VkDescriptorBufferInfo bufferInfos[6] = {
+        { input.meshBuffer, 0u, VK_WHOLE_SIZE },
+        { input.instanceBuffer, 0u, VK_WHOLE_SIZE },
+        { input.boundsBuffer, 0u, VK_WHOLE_SIZE },
+        { frame.drawBuffer, 0u, VK_WHOLE_SIZE },
+        { frame.counterBuffer, 0u, VK_WHOLE_SIZE },
+        { frame.constantBuffer, 0u, VK_WHOLE_SIZE },
+    };
+
+    VkDescriptorImageInfo depthPyramidInfo = {};
+    {
+        depthPyramidInfo.sampler     = pCulling->depthPyramidSampler;
+        depthPyramidInfo.imageView   = input.depthPyramid;
+        depthPyramidInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    VkWriteDescriptorSet writes[7] = {};
+
+    for (uint32_t binding = 0u; binding < 7u; binding++)
+    {
+        writes[binding].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[binding].dstSet          = frame.descriptorSet;
+        writes[binding].dstBinding      = binding;
+        writes[binding].descriptorCount = 1u;
+        writes[binding].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+        if (binding < 6u)
+            writes[binding].pBufferInfo = &bufferInfos[binding];
+    }
+
+    writes[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    writes[6].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writes[6].pImageInfo     = &depthPyramidInfo;
+
+    vkUpdateDescriptorSets(context.device, occlusion ? 7u : 6u, writes, 0u, nullptr);
+
+    // Cull
+    // ---------------------
+
+    vkCmdFillBuffer(cmd, frame.counterBuffer, 0u, sizeof(CullingCounters), 0u);
+
+    VkMemoryBarrier2 barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+    {
+        barrier.srcStageMask  = VK_PIPELINE_STAGE_2_CLEAR_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                                VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    }
+
+    VkDependencyInfo barriers = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    {
+        barriers.memoryBarrierCount = 1u;
+        barriers.pMemoryBarriers    = &barrier;
+    }
+    vkCmdPipelineBarrier2(cmd, &barriers);
+
+    vkCmdBindPipeline(cmd,
+                      VK_PIPELINE_BIND_POINT_COMPUTE,
+                      occlusion ? pCulling->pipelineOcclusion : pCulling->pipelineFrustum);
+    vkCmdBindDescriptorSets(cmd,
+                            VK_PIPELINE_BIND_POINT_COMPUTE,
+                            pCulling->pipelineLayout,
+                            0u,
+                            1u,
+                            &frame.descriptorSet,
+                            0u,
+                            nullptr);
+    vkCmdDispatch(cmd, (input.instanceCount + kCullingGroupSize - 1u) / kCullingGroupSize, 1u, 1u);
+
+    // Make the draws and counters visible to indirect draws and the readback.
+    {
+        barrier.srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        barrier.dstStageMask =
+            VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COPY_BIT;
+        barrier.dstAccessMask =
+            VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT;
+    }
+    vkCmdPipelineBarrier2(cmd, &barriers);
+
+    VkBufferCopy copy = { 0u, 0u, sizeof(CullingCounters) };
+    vkCmdCopyBuffer(cmd, frame.counterBuffer, frame.readbackBuffer, 1u, &copy);
+
+    // Make the counters visible to the host once the frame fence signals.
+    {
+        barrier.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.dstStageMask  = VK_PIPELINE_STAGE_2_HOST_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    }
+    vkCmdPipelineBarrier2(cmd, &barriers);
+
+    frame.culledFrame = context.frameNumber;
+
+    // Statistics are picked up once this slot's fence signals.
+    context.frameDeletionQueues[frameIndex].push_back(
+        [allocator = context.allocator, pCulling, frameIndex,
+         frameNumber = context.frameNumber, instanceCount = input.instanceCount]()
+        {
+            auto& frame = pCulling->frames[frameIndex];
+
+            ThrowOnFail(vmaInvalidateAllocation(
+                allocator, frame.readbackAllocation, 0u, sizeof(CullingCounters)));
+
+            CullingCounters counters;
+            memcpy(&counters, frame.pReadback, sizeof(CullingCounters));
+
+            pCulling->statistics = { frameNumber,
+                                     instanceCount,
+                                     counters.drawCount,
+                                     counters.frustumCulled,
+                                     counters.occlusionCulled };
+        });
+}
+
+void Aule::DrawCulledInstances(Context& context, uint32_t frameIndex)
+{
+    auto* pCulling = context.pGpuCulling;
+
+    assert(pCulling != nullptr);
+
+    const auto& frame = pCulling->frames[frameIndex];
+
+    // Nothing was culled for this frame.
+    if (frame.culledFrame != context.frameNumber)
+        return;
+
+    vkCmdDrawIndexedIndirectCount(context.frameCommandBuffer[frameIndex],
+                                  frame.drawBuffer,
+                                  0u,
+                                  frame.counterBuffer,
+                                  offsetof(CullingCounters, drawCount),
+                                  pCulling->params.maxInstances,
+                                  sizeof(VkDrawIndexedIndirectCommand));
+}
+
+GpuCullingStatistics Aule::GetGpuCullingStatistics(const Context& context)
+{
+    if (!context.pGpuCulling)
+        return {};
+
+    return context.pGpuCulling->statistics;
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+struct Aule::ImguiTextureCache
+{
+    struct Key
+    {
+        VkImageView   imageView;
+        VkSampler     sampler;
+        VkImageLayout imageLayout;
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            auto hash = std::hash<VkImageView>()(key.imageView);
+            hash ^= std::hash<VkSampler>()(key.sampler) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<uint32_t>()(key.imageLayout) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    struct Entry
+    {
+        VkDescriptorSet          set;
+        uint64_t                 lastUsedFrame;
+        std::list<Key>::iterator lruPosition;
+    };
+
+    // Never allocate more than this many sets from ImGui's pool.
+    uint32_t capacity;
+    uint32_t allocatedSets = 0u;
+
+    // Sets kept free (or on their way back) so new images rarely wait on an
+    // eviction to complete. Only textures idle for a whole frame-in-flight
+    // cycle are evicted for it, so the visible working set is never churned.
+    uint32_t headroom;
+
+    std::unordered_map<Key, Entry, KeyHash> entries;
+
+    // Most recently used at the front.
+    std::list<Key> lru;
+
+    // Evicted sets return here once the frames that drew them complete, and
+    // are rewritten for the next image.
+    std::vector<VkDescriptorSet> freeSets;
+    uint32_t                     pendingSets = 0u;
+
+    ImguiTextureCacheStatistics statistics = {};
+};
+
+static void ReleaseEntry(Context& context, ImguiTextureCache& cache, ImguiTextureCache::Key key)
+{
+    auto entry = cache.entries.find(key);
+
+    cache.lru.erase(entry->second.lruPosition);
+
+    cache.pendingSets++;
+
+    // The current frame may have drawn it too, so it comes back after this
+    // slot's fence.
+    context.frameDeletionQueues[context.frameIndex].push_back(
+        [pCache = &cache, set = entry->second.set]()
+        {
+            pCache->freeSets.push_back(set);
+            pCache->pendingSets--;
+        });
+
+    cache.entries.erase(entry);
+}
+
+// Evicts the least recently used texture if it hasn't been used for at least
+// `minIdleFrames` frames, counting the current one.
+static bool EvictLeastRecentlyUsed(Context&           context,
+                                   ImguiTextureCache& cache,
+                                   uint64_t           minIdleFrames)
+{
+    if (cache.lru.empty())
+        return false;
+
+    const auto key = cache.lru.back();
+
+    if (cache.entries.at(key).lastUsedFrame + minIdleFrames > context.frameNumber)
+        return false;
+
+    ReleaseEntry(context, cache, key);
+
+    cache.statistics.evictedTextures++;
+
+    return true;
+}
+
+void Aule::Internal::CreateImguiTextureCache(Context& context, uint32_t capacity)
+{
+    assert(capacity > 0u);
+
+    auto* pCache = new ImguiTextureCache();
+
+    pCache->capacity = capacity;
+    pCache->headroom = std::max(capacity / 8u, 1u);
+
+    context.pImguiTextureCache = pCache;
+}
+
+void Aule::Internal::DestroyImguiTextureCache(Context& context)
+{
+    auto* pCache = context.pImguiTextureCache;
+
+    if (!pCache)
+        return;
+
+    for (auto& [key, entry] : pCache->entries)
+        ImGui_ImplVulkan_RemoveTexture(entry.set);
+
+    for (auto set : pCache->freeSets)
+        ImGui_ImplVulkan_RemoveTexture(set);
+
+    delete pCache;
+
+    context.pImguiTextureCache = nullptr;
+}
+
+// Implementation
+// -----------------------
+
+ImTextureID Aule::GetImguiTexture(Context&      context,
+                                  VkImageView   imageView,
+                                  VkSampler     sampler,
+                                  VkImageLayout imageLayout)
+{
+    auto* pCache = context.pImguiTextureCache;
+
+    assert(pCache != nullptr);
+
+    const ImguiTextureCache::Key key = { imageView, sampler, imageLayout };
+
+    if (auto entry = pCache->entries.find(key); entry != pCache->entries.end())
+    {
+        entry->second.lastUsedFrame = context.frameNumber;
+        pCache->lru.splice(pCache->lru.begin(), pCache->lru, entry->second.lruPosition);
+
+        return (ImTextureID)entry->second.set;
+    }
+
+    VkDescriptorSet set = VK_NULL_HANDLE;
+
+    if (!pCache->freeSets.empty())
+    {
+        set = pCache->freeSets.back();
+        pCache->freeSets.pop_back();
+
+        // No frame in flight references a free set.
+        VkDescriptorImageInfo imageInfo = {};
+        {
+            imageInfo.sampler     = sampler;
+            imageInfo.imageView   = imageView;
+            imageInfo.imageLayout = imageLayout;
+        }
+
+        VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+        {
+            write.dstSet          = set;
+            write.dstBinding      = 0u;
+            write.descriptorCount = 1u;
+            write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            write.pImageInfo      = &imageInfo;
+        }
+        vkUpdateDescriptorSets(context.device, 1u, &write, 0u, nullptr);
+
+        pCache->statistics.recycledSets++;
+    }
+    else if (pCache->allocatedSets < pCache->capacity)
+    {
+        set = ImGui_ImplVulkan_AddTexture(sampler, imageView, imageLayout);
+
+        pCache->allocatedSets++;
+        pCache->statistics.createdSets++;
+    }
+    else
+    {
+        // Make room for the next frames, this image has to wait for it. Only
+        // textures drawn this frame are protected.
+        EvictLeastRecentlyUsed(context, *pCache, 1u);
+
+        pCache->statistics.misses++;
+
+        return ImTextureID_Invalid;
+    }
+
+    pCache->lru.push_front(key);
+    pCache->entries[key] = { set, context.frameNumber, pCache->lru.begin() };
+
+    // Keep a few sets on their way back once the pool is exhausted, taken
+    // from textures no frame in flight has drawn.
+    if (pCache->allocatedSets == pCache->capacity)
+    {
+        while (pCache->freeSets.size() + pCache->pendingSets < pCache->headroom)
+        {
+            if (!EvictLeastRecentlyUsed(context, *pCache, context.frameImageCount))
+                break;
+        }
+    }
+
+    return (ImTextureID)set;
+}
+
+void Aule::ReleaseImguiTexture(Context& context, VkImageView imageView)
+{
+    auto* pCache = context.pImguiTextureCache;
+
+    if (!pCache)
+        return;
+
+    std::vector<ImguiTextureCache::Key> keys;
+
+    for (const auto& [key, entry] : pCache->entries)
+    {
+        if (key.imageView == imageView)
+            keys.push_back(key);
+    }
+
+    for (const auto& key : keys)
+        ReleaseEntry(context, *pCache, key);
+}
+
+ImguiTextureCacheStatistics Aule::GetImguiTextureCacheStatistics(const Context& context)
+{
+    if (!context.pImguiTextureCache)
+        return {};
+
+    auto statistics = context.pImguiTextureCache->statistics;
+
+    statistics.cachedTextures = static_cast<uint32_t>(context.pImguiTextureCache->entries.size());
+
+    return statistics;
+}
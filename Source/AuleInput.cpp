@@ -0,0 +1,598 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+// File layout: magic, version, window width and height (int32), followed by
+// events of [frame (uint32), type (uint8), int32 values, double values], the
+// value counts depending on the type. The End event carries the frame count.
+static constexpr char     kInputMagic[8] = { 'A', 'U', 'L', 'E', 'I', 'N', 'P', 'T' };
+static constexpr uint32_t kInputVersion  = 1u;
+
+enum class InputEventType : uint8_t
+{
+    Key,
+    Char,
+    MouseButton,
+    CursorPos,
+    Scroll,
+    CursorEnter,
+    Focus,
+    WindowSize,
+    End,
+    Count
+};
+
+// Values stored per event type.
+static constexpr uint32_t kInputIntCount[]    = { 4u, 1u, 3u, 0u, 0u, 1u, 1u, 2u, 0u };
+static constexpr uint32_t kInputDoubleCount[] = { 0u, 0u, 0u, 2u, 2u, 0u, 0u, 0u, 0u };
+
+struct InputEvent
+{
+    uint32_t       frame;
+    InputEventType type;
+    int32_t        values[4];
+    double         positions[2];
+};
+
+struct Aule::InputRecorder
+{
+    enum class Mode
+    {
+        Recording,
+        Replaying
+    };
+
+    Mode        mode;
+    GLFWwindow* window;
+
+    // Callbacks installed before ours, ImGui's backend unless disabled. They
+    // receive recorded events, replayed ones unless ImGui takes them, and are
+    // restored at the end.
+    GLFWkeyfun         previousKey;
+    GLFWcharfun        previousChar;
+    GLFWmousebuttonfun previousMouseButton;
+    GLFWcursorposfun   previousCursorPos;
+    GLFWscrollfun      previousScroll;
+    GLFWcursorenterfun previousCursorEnter;
+    GLFWwindowfocusfun previousFocus;
+    GLFWwindowsizefun  previousWindowSize;
+
+    // Context frame the recording or replay started on, set on the first
+    // frame after Begin, and the current frame relative to it.
+    uint64_t firstFrame = UINT64_MAX;
+    uint32_t frame      = 0u;
+
+    // Recording.
+    std::ofstream output;
+
+    // Replay.
+    std::vector<InputEvent> events;
+    size_t                  nextEvent  = 0u;
+    uint32_t                frameCount = 0u;
+    InputReplayParams       params;
+    std::ofstream           timing;
+
+#ifdef AULE_ENABLE_IMGUI
+    // Replayed events go to ImGui's IO instead of its GLFW backend, which
+    // reads the live modifier keys and cursor alongside each event.
+    bool imgui = false;
+#endif
+};
+
+// GLFW callbacks carry no user data.
+static InputRecorder* spInput = nullptr;
+
+static void WriteInputEvent(InputRecorder& input, const InputEvent& event)
+{
+    const auto type = static_cast<uint32_t>(event.type);
+
+    input.output.write(reinterpret_cast<const char*>(&event.frame), sizeof(uint32_t));
+    input.output.write(reinterpret_cast<const char*>(&event.type), sizeof(uint8_t));
+    input.output.write(reinterpret_cast<const char*>(event.values),
+                       sizeof(int32_t) * kInputIntCount[type]);
+    input.output.write(reinterpret_cast<const char*>(event.positions),
+                       sizeof(double) * kInputDoubleCount[type]);
+}
+
+static bool ReadInputEvent(std::ifstream& file, InputEvent& event)
+{
+    event = {};
+
+    file.read(reinterpret_cast<char*>(&event.frame), sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(&event.type), sizeof(uint8_t));
+
+    if (!file || event.type >= InputEventType::Count)
+        return false;
+
+    const auto type = static_cast<uint32_t>(event.type);
+
+    file.read(reinterpret_cast<char*>(event.values), sizeof(int32_t) * kInputIntCount[type]);
+    file.read(reinterpret_cast<char*>(event.positions), sizeof(double) * kInputDoubleCount[type]);
+
+    return static_cast<bool>(file);
+}
+
+// Records the event if recording, returns false if it must not reach the
+// previous callbacks because a replay owns the input.
+static bool RecordInputEvent(InputEventType          type,
+                             std::array<int32_t, 4u> values,
+                             std::array<double, 2u>  positions = {})
+{
+    if (spInput->mode == InputRecorder::Mode::Replaying)
+        return false;
+
+    // Events polled before the first recorded frame are passed through only.
+    if (spInput->firstFrame == UINT64_MAX)
+        return true;
+
+    InputEvent event = {};
+    {
+        event.frame = spInput->frame;
+        event.type  = type;
+
+        std::copy(values.begin(), values.end(), event.values);
+        std::copy(positions.begin(), positions.end(), event.positions);
+    }
+    WriteInputEvent(*spInput, event);
+
+    return true;
+}
+
+static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (RecordInputEvent(InputEventType::Key, { key, scancode, action, mods }) &&
+        spInput->previousKey)
+        spInput->previousKey(window, key, scancode, action, mods);
+}
+
+static void CharCallback(GLFWwindow* window, unsigned int codepoint)
+{
+    if (RecordInputEvent(InputEventType::Char, { static_cast<int32_t>(codepoint) }) &&
+        spInput->previousChar)
+        spInput->previousChar(window, codepoint);
+}
+
+static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    if (RecordInputEvent(InputEventType::MouseButton, { button, action, mods }) &&
+        spInput->previousMouseButton)
+        spInput->previousMouseButton(window, button, action, mods);
+}
+
+static void CursorPosCallback(GLFWwindow* window, double x, double y)
+{
+    if (RecordInputEvent(InputEventType::CursorPos, {}, { x, y }) && spInput->previousCursorPos)
+        spInput->previousCursorPos(window, x, y);
+}
+
+static void ScrollCallback(GLFWwindow* window, double x, double y)
+{
+    if (RecordInputEvent(InputEventType::Scroll, {}, { x, y }) && spInput->previousScroll)
+        spInput->previousScroll(window, x, y);
+}
+
+static void CursorEnterCallback(GLFWwindow* window, int entered)
+{
+    if (RecordInputEvent(InputEventType::CursorEnter, { entered }) &&
+        spInput->previousCursorEnter)
+        spInput->previousCursorEnter(window, entered);
+}
+
+static void FocusCallback(GLFWwindow* window, int focused)
+{
+    if (RecordInputEvent(InputEventType::Focus, { focused }) && spInput->previousFocus)
+        spInput->previousFocus(window, focused);
+}
+
+static void WindowSizeCallback(GLFWwindow* window, int width, int height)
+{
+    // Replayed sizes are applied with glfwSetWindowSize and come through here.
+    if (spInput->mode == InputRecorder::Mode::Recording)
+        RecordInputEvent(InputEventType::WindowSize, { width, height });
+
+    if (spInput->previousWindowSize)
+        spInput->previousWindowSize(window, width, height);
+}
+
+static void InstallInputCallbacks(InputRecorder& input)
+{
+    input.previousKey         = glfwSetKeyCallback(input.window, KeyCallback);
+    input.previousChar        = glfwSetCharCallback(input.window, CharCallback);
+    input.previousMouseButton = glfwSetMouseButtonCallback(input.window, MouseButtonCallback);
+    input.previousCursorPos   = glfwSetCursorPosCallback(input.window, CursorPosCallback);
+    input.previousScroll      = glfwSetScrollCallback(input.window, ScrollCallback);
+    input.previousCursorEnter = glfwSetCursorEnterCallback(input.window, CursorEnterCallback);
+    input.previousFocus       = glfwSetWindowFocusCallback(input.window, FocusCallback);
+    input.previousWindowSize  = glfwSetWindowSizeCallback(input.window, WindowSizeCallback);
+}
+
+static void RestoreInputCallbacks(InputRecorder& input)
+{
+    glfwSetKeyCallback(input.window, input.previousKey);
+    glfwSetCharCallback(input.window, input.previousChar);
+    glfwSetMouseButtonCallback(input.window, input.previousMouseButton);
+    glfwSetCursorPosCallback(input.window, input.previousCursorPos);
+    glfwSetScrollCallback(input.window, input.previousScroll);
+    glfwSetCursorEnterCallback(input.window, input.previousCursorEnter);
+    glfwSetWindowFocusCallback(input.window, input.previousFocus);
+    glfwSetWindowSizeCallback(input.window, input.previousWindowSize);
+}
+
+#ifdef AULE_ENABLE_IMGUI
+// GLFW may report the modifiers from before a modifier key's own event, so
+// the modifier the key changes is patched in.
+static int32_t GetModifiersAfterKey(int32_t key, int32_t action, int32_t mods)
+{
+    int32_t modifier = 0;
+
+    switch (key)
+    {
+        case GLFW_KEY_LEFT_CONTROL:
+        case GLFW_KEY_RIGHT_CONTROL:
+            modifier = GLFW_MOD_CONTROL;
+            break;
+        case GLFW_KEY_LEFT_SHIFT:
+        case GLFW_KEY_RIGHT_SHIFT:
+            modifier = GLFW_MOD_SHIFT;
+            break;
+        case GLFW_KEY_LEFT_ALT:
+        case GLFW_KEY_RIGHT_ALT:
+            modifier = GLFW_MOD_ALT;
+            break;
+        case GLFW_KEY_LEFT_SUPER:
+        case GLFW_KEY_RIGHT_SUPER:
+            modifier = GLFW_MOD_SUPER;
+            break;
+        default:
+            break;
+    }
+
+    return action == GLFW_RELEASE ? mods & ~modifier : mods | modifier;
+}
+
+static void AddImguiModifiers(ImGuiIO& io, int32_t mods)
+{
+    io.AddKeyEvent(ImGuiMod_Ctrl, (mods & GLFW_MOD_CONTROL) != 0);
+    io.AddKeyEvent(ImGuiMod_Shift, (mods & GLFW_MOD_SHIFT) != 0);
+    io.AddKeyEvent(ImGuiMod_Alt, (mods & GLFW_MOD_ALT) != 0);
+    io.AddKeyEvent(ImGuiMod_Super, (mods & GLFW_MOD_SUPER) != 0);
+}
+
+// Mirrors ImGui's GLFW backend callbacks, with the recorded modifiers.
+static bool InjectImguiEvent(const InputEvent& event)
+{
+    const auto* v = event.values;
+    const auto* p = event.positions;
+
+    auto& io = ImGui::GetIO();
+
+    switch (event.type)
+    {
+        case InputEventType::Key:
+        {
+            if (v[2] != GLFW_PRESS && v[2] != GLFW_RELEASE)
+                break;
+
+            AddImguiModifiers(io, GetModifiersAfterKey(v[0], v[2], v[3]));
+
+            const auto key = ImGui_ImplGlfw_KeyToImGuiKey(v[0], v[1]);
+
+            io.AddKeyEvent(key, v[2] == GLFW_PRESS);
+            io.SetKeyEventNativeData(key, v[0], v[1]);
+            break;
+        }
+        case InputEventType::Char:
+            io.AddInputCharacter(static_cast<unsigned int>(v[0]));
+            break;
+        case InputEventType::MouseButton:
+            AddImguiModifiers(io, v[2]);
+
+            if (v[0] >= 0 && v[0] < ImGuiMouseButton_COUNT)
+                io.AddMouseButtonEvent(v[0], v[1] == GLFW_PRESS);
+            break;
+        case InputEventType::CursorPos:
+            io.AddMousePosEvent(static_cast<float>(p[0]), static_cast<float>(p[1]));
+            break;
+        case InputEventType::Scroll:
+            io.AddMouseWheelEvent(static_cast<float>(p[0]), static_cast<float>(p[1]));
+            break;
+        case InputEventType::CursorEnter:
+            // The backend keeps treating the cursor as inside, see BeginInputReplay.
+            if (!v[0])
+                io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+            break;
+        case InputEventType::Focus:
+            io.AddFocusEvent(v[0] != 0);
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+#endif
+
+static void InjectInputEvent(InputRecorder& input, const InputEvent& event)
+{
+#ifdef AULE_ENABLE_IMGUI
+    if (input.imgui && InjectImguiEvent(event))
+        return;
+#endif
+
+    const auto* v = event.values;
+    const auto* p = event.positions;
+
+    switch (event.type)
+    {
+        case InputEventType::Key:
+            if (input.previousKey)
+                input.previousKey(input.window, v[0], v[1], v[2], v[3]);
+            break;
+        case InputEventType::Char:
+            if (input.previousChar)
+                input.previousChar(input.window, static_cast<unsigned int>(v[0]));
+            break;
+        case InputEventType::MouseButton:
+            if (input.previousMouseButton)
+                input.previousMouseButton(input.window, v[0], v[1], v[2]);
+            break;
+        case InputEventType::CursorPos:
+            if (input.previousCursorPos)
+                input.previousCursorPos(input.window, p[0], p[1]);
+            break;
+        case InputEventType::Scroll:
+            if (input.previousScroll)
+                input.previousScroll(input.window, p[0], p[1]);
+            break;
+        case InputEventType::CursorEnter:
+            if (input.previousCursorEnter)
+                input.previousCursorEnter(input.window, v[0]);
+            break;
+        case InputEventType::Focus:
+            if (input.previousFocus)
+                input.previousFocus(input.window, v[0]);
+            break;
+        case InputEventType::WindowSize:
+            glfwSetWindowSize(input.window, v[0], v[1]);
+            break;
+        default:
+            break;
+    }
+}
+
+void Aule::Internal::UpdateInput(Context& context)
+{
+    auto* pInput = context.pInput;
+
+    if (!pInput)
+        return;
+
+    if (pInput->firstFrame == UINT64_MAX)
+        pInput->firstFrame = context.frameNumber;
+
+    pInput->frame = static_cast<uint32_t>(context.frameNumber - pInput->firstFrame);
+
+    if (pInput->mode == InputRecorder::Mode::Recording)
+        return;
+
+    // Wall time of the previous replayed frame, measured by Dispatch.
+    if (pInput->frame > 0u)
+        pInput->timing << pInput->frame - 1u << "," << context.frameDeltaTime * 1000.0f << "\n";
+
+    if (pInput->frame >= pInput->frameCount)
+    {
+        if (pInput->params.closeWindowOnEnd)
+            glfwSetWindowShouldClose(pInput->window, GLFW_TRUE);
+
+        EndInputReplay(context);
+
+        return;
+    }
+
+    while (pInput->nextEvent < pInput->events.size() &&
+           pInput->events[pInput->nextEvent].frame <= pInput->frame)
+        InjectInputEvent(*pInput, pInput->events[pInput->nextEvent++]);
+
+    context.frameDeltaTime = pInput->params.fixedDeltaTime;
+}
+
+// Implementation
+// -----------------------
+
+void Aule::BeginInputRecording(Context& context, const char* outputPath)
+{
+    assert(context.pInput == nullptr);
+    assert(outputPath != nullptr);
+
+    auto* pInput = new InputRecorder();
+    {
+        pInput->mode   = InputRecorder::Mode::Recording;
+        pInput->window = context.window;
+        pInput->output.open(outputPath, std::ios::binary);
+    }
+
+    if (!pInput->output)
+    {
+        delete pInput;
+        throw std::runtime_error("Failed to open input recording file.");
+    }
+
+    int32_t windowSize[2];
+    glfwGetWindowSize(context.window, &windowSize[0], &windowSize[1]);
+
+    pInput->output.write(kInputMagic, sizeof(kInputMagic));
+    pInput->output.write(reinterpret_cast<const char*>(&kInputVersion), sizeof(uint32_t));
+    pInput->output.write(reinterpret_cast<const char*>(windowSize), sizeof(windowSize));
+
+    InstallInputCallbacks(*pInput);
+
+    // GLFW doesn't report a cursor already inside the window as entering it,
+    // and ImGui's backend polls the cursor until it does. Record it entering
+    // on the first frame instead, so every position comes from the callbacks.
+    if (glfwGetWindowAttrib(context.window, GLFW_HOVERED))
+    {
+        InputEvent event = {};
+        {
+            event.type      = InputEventType::CursorEnter;
+            event.values[0] = GLFW_TRUE;
+        }
+        WriteInputEvent(*pInput, event);
+
+        event.type = InputEventType::CursorPos;
+        glfwGetCursorPos(context.window, &event.positions[0], &event.positions[1]);
+
+        WriteInputEvent(*pInput, event);
+
+        if (pInput->previousCursorEnter)
+            pInput->previousCursorEnter(context.window, GLFW_TRUE);
+    }
+
+    spInput        = pInput;
+    context.pInput = pInput;
+}
+
+void Aule::EndInputRecording(Context& context)
+{
+    auto* pInput = context.pInput;
+
+    if (!pInput || pInput->mode != InputRecorder::Mode::Recording)
+        return;
+
+    // Number of frames started since the recording began.
+    InputEvent event = {};
+    {
+        event.frame = pInput->firstFrame == UINT64_MAX ? 0u : pInput->frame + 1u;
+        event.type  = InputEventType::End;
+    }
+    WriteInputEvent(*pInput, event);
+
+    RestoreInputCallbacks(*pInput);
+
+    delete pInput;
+
+    spInput        = nullptr;
+    context.pInput = nullptr;
+}
+
+void Aule::BeginInputReplay(Context& context, const InputReplayParams& params)
+{
+    assert(context.pInput == nullptr);
+    assert(params.inputPath != nullptr);
+    assert(params.fixedDeltaTime > 0.0f);
+
+    std::ifstream file(params.inputPath, std::ios::binary);
+
+    char     magic[8];
+    uint32_t version = 0u;
+    int32_t  windowSize[2];
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(windowSize), sizeof(windowSize));
+
+    if (!file || memcmp(magic, kInputMagic, sizeof(kInputMagic)) != 0 ||
+        version != kInputVersion)
+        throw std::runtime_error("Invalid input recording file.");
+
+    auto* pInput = new InputRecorder();
+    {
+        pInput->mode   = InputRecorder::Mode::Replaying;
+        pInput->window = context.window;
+        pInput->params = params;
+    }
+
+    InputEvent event;
+
+    while (ReadInputEvent(file, event))
+    {
+        if (event.type == InputEventType::End)
+        {
+            pInput->frameCount = event.frame;
+            break;
+        }
+
+        pInput->events.push_back(event);
+    }
+
+    // A recording cut short still replays up to its last event.
+    if (pInput->frameCount == 0u && !pInput->events.empty())
+        pInput->frameCount = pInput->events.back().frame + 1u;
+
+    if (params.timingPath)
+    {
+        pInput->timing.open(params.timingPath);
+        pInput->timing << "frame,frameTimeMs\n";
+    }
+
+    glfwSetWindowSize(context.window, windowSize[0], windowSize[1]);
+
+    InstallInputCallbacks(*pInput);
+
+#ifdef AULE_ENABLE_IMGUI
+    pInput->imgui = context.imguiEnabled;
+
+    if (pInput->imgui)
+    {
+        auto& io = ImGui::GetIO();
+
+        // Drop the keys and buttons held live, and have the backend treat the
+        // cursor as inside the window so it never polls it. Until the
+        // recording moves it, the cursor is nowhere.
+        io.ClearInputKeys();
+        io.ClearInputMouse();
+
+        if (pInput->previousCursorEnter)
+            pInput->previousCursorEnter(context.window, GLFW_TRUE);
+
+        io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+    }
+#endif
+
+    spInput        = pInput;
+    context.pInput = pInput;
+}
+
+void Aule::EndInputReplay(Context& context)
+{
+    auto* pInput = context.pInput;
+
+    if (!pInput || pInput->mode != InputRecorder::Mode::Replaying)
+        return;
+
+    RestoreInputCallbacks(*pInput);
+
+    delete pInput;
+
+    spInput        = nullptr;
+    context.pInput = nullptr;
+}
+
+bool Aule::IsReplayingInput(const Context& context)
+{
+    return context.pInput && context.pInput->mode == InputRecorder::Mode::Replaying;
+}
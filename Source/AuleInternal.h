@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef AULE_INTERNAL_H
+#define AULE_INTERNAL_H
+
+#include "../Include/Aule/Aule.h"
+
+inline void ThrowOnFail(bool succeeded)
+{
+    if (!succeeded)
+        throw std::runtime_error("Internal Vulkan call failed.");
+}
+
+inline void ThrowOnFail(VkResult result) { ThrowOnFail(result == VK_SUCCESS); }
+
+namespace Aule
+{
+    namespace Internal
+    {
+        // Execute and clear every lambda in a frame's deletion queue. Only safe
+        // once the GPU has finished with the frame that filled it.
+        void FlushDeletionQueue(std::deque<std::function<void()>>& deletionQueue);
+
+        // Size in bytes of one texel of an uncompressed format, zero if the
+        // format isn't supported.
+        uint32_t GetTexelSize(VkFormat format);
+
+        // Size in bytes of tightly packed image data, including BC formats.
+        // Zero if the format isn't supported.
+        VkDeviceSize GetImageSize(VkFormat format, uint32_t width, uint32_t height);
+
+        // Device Setup
+        // -----------------------
+
+        // Creates a Vulkan 1.3 instance and loads its entry points.
+        VkInstance CreateInstance(const char*        applicationName,
+                                  const char* const* ppExtensions,
+                                  uint32_t           extensionCount);
+
+        // Picks the first device whose name contains the hint, else device zero.
+        void SelectPhysicalDevice(VkInstance                            instance,
+                                  const char*                           deviceHint,
+                                  VkPhysicalDevice&                     physicalDevice,
+                                  VkPhysicalDeviceProperties&           properties,
+                                  std::vector<VkQueueFamilyProperties>& queueFamilies);
+
+        // Creates the device with one queue per family and loads its entry
+        // points. Throws if a required extension is unsupported, requested ones
+        // are skipped with a warning instead. Every extension the device was
+        // created with is stored in `enabledExtensions`.
+        VkDevice CreateDevice(VkPhysicalDevice                       physicalDevice,
+                              uint32_t                               queueFamilyCount,
+                              const std::vector<const char*>&        requiredExtensions,
+                              const std::vector<const char*>&        requestedExtensions,
+                              const void*                            pFeatures,
+                              std::unordered_map<uint32_t, VkQueue>& queues,
+                              std::vector<std::string>&              enabledExtensions);
+
+        VmaAllocator CreateAllocator(VkInstance       instance,
+                                     VkPhysicalDevice physicalDevice,
+                                     VkDevice         device);
+
+        // Capture
+        // -----------------------
+
+        // Records the swapchain image copy for the active capture, if any. The
+        // swapchain image is expected in TRANSFER_SRC_OPTIMAL.
+        void CaptureSwapchain(Context& context, uint32_t frameIndex);
+
+        // True if the active capture wants the swapchain image every frame.
+        bool IsCapturingSwapchain(const Context& context);
+
+        // Texture Streamer
+        // -----------------------
+
+        // Records residency changes for this frame. Returns a semaphore the
+        // frame submission must wait on if uploads went to the transfer queue.
+        VkSemaphore UpdateTextureStreamer(Context& context, uint32_t frameIndex);
+
+        // Called once the device is idle.
+        void DestroyTextureStreamer(Context& context);
+
+        // File Loader
+        // -----------------------
+
+        // Records the copies of imported and staged file data for this frame,
+        // within the per-frame copy budget.
+        void UpdateFileLoader(Context& context, uint32_t frameIndex);
+
+        // Called once the device is idle and the deletion queues are flushed.
+        void DestroyFileLoader(Context& context);
+
+        // Command Cache
+        // -----------------------
+
+        // Called once the device is idle and the deletion queues are flushed.
+        void DestroyCommandCache(Context& context);
+
+        // Resources
+        // -----------------------
+
+        void CreateResourceRegistry(Context& context);
+
+        // Called once the device is idle and the deletion queues are flushed.
+        void DestroyResourceRegistry(Context& context);
+
+        // Input
+        // -----------------------
+
+        // Starts the frame of an input recording or replay, injecting the
+        // replayed events and fixing the delta time. Called before polling.
+        void UpdateInput(Context& context);
+
+        // Dynamic Resolution
+        // -----------------------
+
+        // Reads back the slot's previous timestamps to pick this frame's render
+        // extent, and hands the target over in COLOR_ATTACHMENT_OPTIMAL.
+        void BeginDynamicResolution(Context& context, uint32_t frameIndex);
+
+        // Upscales the target into the swapchain image, leaving it in
+        // TRANSFER_DST_OPTIMAL. False if dynamic resolution is off this frame.
+        bool ResolveDynamicResolution(Context& context,
+                                      uint32_t frameIndex,
+                                      VkImage  swapchainImage);
+
+        // Closes the frame's timestamp pair, recorded last in the command buffer.
+        void EndDynamicResolution(Context& context, uint32_t frameIndex);
+
+        // Called once the device is idle.
+        void DestroyDynamicResolution(Context& context);
+
+#ifdef AULE_ENABLE_IMGUI
+        // ImGui Texture Cache
+        // -----------------------
+
+        void CreateImguiTextureCache(Context& context, uint32_t capacity);
+
+        // Called before ImGui shuts down, once the deletion queues are flushed.
+        void DestroyImguiTextureCache(Context& context);
+#endif
+
+#ifdef AULE_ENABLE_GPU_CULLING
+        // GPU Culling
+        // -----------------------
+
+        // Called once the device is idle and the deletion queues are flushed.
+        void DestroyGpuCulling(Context& context);
+#endif
+    } // namespace Internal
+} // namespace Aule
+
+#endif
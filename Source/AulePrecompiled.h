@@ -33,6 +33,14 @@
 #include <array>
 #include <stdexcept>
 #include <deque>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <cmath>
+#include <list>
 
 // Volk
 // -----------------
@@ -52,9 +60,11 @@
 // Imgui
 // -----------------
 
+#ifdef AULE_ENABLE_IMGUI
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_vulkan.h>
 #include <imgui.h>
+#endif
 
 // GLM
 // -----------------
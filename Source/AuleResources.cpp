@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+static constexpr uint32_t kHandleIndexBits      = 20u;
+static constexpr uint32_t kHandleIndexMask      = (1u << kHandleIndexBits) - 1u;
+static constexpr uint32_t kHandleGenerationMask = (1u << (32u - kHandleIndexBits)) - 1u;
+
+// Slot bookkeeping shared by every pool. The objects themselves live in
+// parallel arrays of the pool, indexed by slot.
+struct HandleSlots
+{
+    // Generation of the handle currently valid for each slot, never zero.
+    std::vector<uint16_t> generations;
+
+    // Slots whose object has been released and may be handed out again.
+    std::vector<uint32_t> freeSlots;
+
+    uint32_t Allocate()
+    {
+        if (!freeSlots.empty())
+        {
+            const auto index = freeSlots.back();
+            freeSlots.pop_back();
+            return index;
+        }
+
+        const auto index = static_cast<uint32_t>(generations.size());
+
+        ThrowOnFail(index <= kHandleIndexMask);
+
+        generations.push_back(1u);
+
+        return index;
+    }
+
+    uint32_t GetHandle(uint32_t index) const
+    {
+        return (static_cast<uint32_t>(generations[index]) << kHandleIndexBits) | index;
+    }
+
+    bool IsValid(uint32_t handle) const
+    {
+        const auto index = handle & kHandleIndexMask;
+
+        return handle != 0u && index < generations.size() &&
+               generations[index] == handle >> kHandleIndexBits;
+    }
+
+    uint32_t Resolve(uint32_t handle) const
+    {
+        if (!IsValid(handle))
+            throw std::runtime_error("Stale or invalid resource handle.");
+
+        return handle & kHandleIndexMask;
+    }
+
+    // Outstanding handles to the slot become stale.
+    void Invalidate(uint32_t index)
+    {
+        generations[index] = static_cast<uint16_t>(generations[index] % kHandleGenerationMask + 1u);
+    }
+};
+
+struct Aule::ResourceRegistry
+{
+    // Live slots hold a non-null object.
+
+    struct
+    {
+        HandleSlots                slots;
+        std::vector<VkBuffer>      buffers;
+        std::vector<VmaAllocation> allocations;
+        std::vector<VkDeviceSize>  sizes;
+        std::vector<void*>         mappedData;
+    } buffers;
+
+    struct
+    {
+        HandleSlots                slots;
+        std::vector<VkImage>       images;
+        std::vector<VmaAllocation> allocations;
+        std::vector<VkFormat>      formats;
+        std::vector<VkExtent3D>    extents;
+    } images;
+
+    struct
+    {
+        HandleSlots              slots;
+        std::vector<VkImageView> imageViews;
+    } imageViews;
+
+    struct
+    {
+        HandleSlots            slots;
+        std::vector<VkSampler> samplers;
+    } samplers;
+};
+
+// Returns the slot for a new object, growing the pool's arrays if needed.
+template <typename Pool, typename... Arrays>
+static uint32_t AllocateSlot(Pool& pool, Arrays&... arrays)
+{
+    const auto index = pool.slots.Allocate();
+
+    if (index >= pool.slots.generations.size() - 1u)
+        (arrays.resize(pool.slots.generations.size()), ...);
+
+    return index;
+}
+
+// Invalidates the handle now and returns its slot to the pool once the current
+// frame slot completes, after `release` destroyed the object.
+template <typename Pool>
+static void ReleaseSlot(Context& context, Pool& pool, uint32_t index, std::function<void()> release)
+{
+    pool.slots.Invalidate(index);
+
+    context.frameDeletionQueues[context.frameIndex].push_back(
+        [&pool, index, release = std::move(release)]()
+        {
+            release();
+            pool.slots.freeSlots.push_back(index);
+        });
+}
+
+void Aule::Internal::CreateResourceRegistry(Context& context)
+{
+    context.pResources = new ResourceRegistry();
+}
+
+void Aule::Internal::DestroyResourceRegistry(Context& context)
+{
+    auto* pResources = context.pResources;
+
+    if (!pResources)
+        return;
+
+    // Release whatever the application left alive, views ahead of images.
+    for (auto imageView : pResources->imageViews.imageViews)
+    {
+        if (imageView)
+            vkDestroyImageView(context.device, imageView, nullptr);
+    }
+
+    for (auto sampler : pResources->samplers.samplers)
+    {
+        if (sampler)
+            vkDestroySampler(context.device, sampler, nullptr);
+    }
+
+    for (size_t index = 0u; index < pResources->images.images.size(); index++)
+    {
+        if (pResources->images.images[index])
+            vmaDestroyImage(context.allocator,
+                            pResources->images.images[index],
+                            pResources->images.allocations[index]);
+    }
+
+    for (size_t index = 0u; index < pResources->buffers.buffers.size(); index++)
+    {
+        if (pResources->buffers.buffers[index])
+            vmaDestroyBuffer(context.allocator,
+                             pResources->buffers.buffers[index],
+                             pResources->buffers.allocations[index]);
+    }
+
+    delete pResources;
+
+    context.pResources = nullptr;
+}
+
+// Implementation
+// -----------------------
+
+BufferHandle Aule::CreateBuffer(Context&                       context,
+                                const VkBufferCreateInfo&      bufferInfo,
+                                const VmaAllocationCreateInfo& allocationInfo)
+{
+    auto& pool = context.pResources->buffers;
+
+    VkBuffer          buffer;
+    VmaAllocation     allocation;
+    VmaAllocationInfo allocationResult;
+    ThrowOnFail(vmaCreateBuffer(
+        context.allocator, &bufferInfo, &allocationInfo, &buffer, &allocation, &allocationResult));
+
+    const auto index =
+        AllocateSlot(pool, pool.buffers, pool.allocations, pool.sizes, pool.mappedData);
+
+    pool.buffers[index]     = buffer;
+    pool.allocations[index] = allocation;
+    pool.sizes[index]       = bufferInfo.size;
+    pool.mappedData[index]  = allocationResult.pMappedData;
+
+    return { pool.slots.GetHandle(index) };
+}
+
+ImageHandle Aule::CreateImage(Context&                       context,
+                              const VkImageCreateInfo&       imageInfo,
+                              const VmaAllocationCreateInfo& allocationInfo)
+{
+    auto& pool = context.pResources->images;
+
+    VkImage       image;
+    VmaAllocation allocation;
+    ThrowOnFail(vmaCreateImage(
+        context.allocator, &imageInfo, &allocationInfo, &image, &allocation, nullptr));
+
+    const auto index =
+        AllocateSlot(pool, pool.images, pool.allocations, pool.formats, pool.extents);
+
+    pool.images[index]      = image;
+    pool.allocations[index] = allocation;
+    pool.formats[index]     = imageInfo.format;
+    pool.extents[index]     = imageInfo.extent;
+
+    return { pool.slots.GetHandle(index) };
+}
+
+ImageViewHandle Aule::CreateImageView(Context&                     context,
+                                      ImageHandle                  image,
+                                      const VkImageViewCreateInfo& imageViewInfo)
+{
+    auto& pool = context.pResources->imageViews;
+
+    auto viewInfo  = imageViewInfo;
+    viewInfo.image = GetImage(context, image);
+
+    VkImageView imageView;
+    ThrowOnFail(vkCreateImageView(context.device, &viewInfo, nullptr, &imageView));
+
+    const auto index = AllocateSlot(pool, pool.imageViews);
+
+    pool.imageViews[index] = imageView;
+
+    return { pool.slots.GetHandle(index) };
+}
+
+SamplerHandle Aule::CreateSampler(Context& context, const VkSamplerCreateInfo& samplerInfo)
+{
+    auto& pool = context.pResources->samplers;
+
+    VkSampler sampler;
+    ThrowOnFail(vkCreateSampler(context.device, &samplerInfo, nullptr, &sampler));
+
+    const auto index = AllocateSlot(pool, pool.samplers);
+
+    pool.samplers[index] = sampler;
+
+    return { pool.slots.GetHandle(index) };
+}
+
+void Aule::DestroyBuffer(Context& context, BufferHandle buffer)
+{
+    if (buffer.value == 0u)
+        return;
+
+    auto& pool = context.pResources->buffers;
+
+    const auto index = pool.slots.Resolve(buffer.value);
+
+    ReleaseSlot(context,
+                pool,
+                index,
+                [allocator  = context.allocator,
+                 buffer     = pool.buffers[index],
+                 allocation = pool.allocations[index]]()
+                { vmaDestroyBuffer(allocator, buffer, allocation); });
+
+    pool.buffers[index] = VK_NULL_HANDLE;
+}
+
+void Aule::DestroyImage(Context& context, ImageHandle image)
+{
+    if (image.value == 0u)
+        return;
+
+    auto& pool = context.pResources->images;
+
+    const auto index = pool.slots.Resolve(image.value);
+
+    ReleaseSlot(context,
+                pool,
+                index,
+                [allocator  = context.allocator,
+                 image      = pool.images[index],
+                 allocation = pool.allocations[index]]()
+                { vmaDestroyImage(allocator, image, allocation); });
+
+    pool.images[index] = VK_NULL_HANDLE;
+}
+
+void Aule::DestroyImageView(Context& context, ImageViewHandle imageView)
+{
+    if (imageView.value == 0u)
+        return;
+
+    auto& pool = context.pResources->imageViews;
+
+    const auto index = pool.slots.Resolve(imageView.value);
+
+    ReleaseSlot(context,
+                pool,
+                index,
+                [device = context.device, imageView = pool.imageViews[index]]()
+                { vkDestroyImageView(device, imageView, nullptr); });
+
+    pool.imageViews[index] = VK_NULL_HANDLE;
+}
+
+void Aule::DestroySampler(Context& context, SamplerHandle sampler)
+{
+    if (sampler.value == 0u)
+        return;
+
+    auto& pool = context.pResources->samplers;
+
+    const auto index = pool.slots.Resolve(sampler.value);
+
+    ReleaseSlot(context,
+                pool,
+                index,
+                [device = context.device, sampler = pool.samplers[index]]()
+                { vkDestroySampler(device, sampler, nullptr); });
+
+    pool.samplers[index] = VK_NULL_HANDLE;
+}
+
+bool Aule::IsValid(const Context& context, BufferHandle buffer)
+{
+    return context.pResources->buffers.slots.IsValid(buffer.value);
+}
+
+bool Aule::IsValid(const Context& context, ImageHandle image)
+{
+    return context.pResources->images.slots.IsValid(image.value);
+}
+
+bool Aule::IsValid(const Context& context, ImageViewHandle imageView)
+{
+    return context.pResources->imageViews.slots.IsValid(imageView.value);
+}
+
+bool Aule::IsValid(const Context& context, SamplerHandle sampler)
+{
+    return context.pResources->samplers.slots.IsValid(sampler.value);
+}
+
+VkBuffer Aule::GetBuffer(const Context& context, BufferHandle buffer)
+{
+    const auto& pool = context.pResources->buffers;
+    return pool.buffers[pool.slots.Resolve(buffer.value)];
+}
+
+VmaAllocation Aule::GetBufferAllocation(const Context& context, BufferHandle buffer)
+{
+    const auto& pool = context.pResources->buffers;
+    return pool.allocations[pool.slots.Resolve(buffer.value)];
+}
+
+VkDeviceSize Aule::GetBufferSize(const Context& context, BufferHandle buffer)
+{
+    const auto& pool = context.pResources->buffers;
+    return pool.sizes[pool.slots.Resolve(buffer.value)];
+}
+
+void* Aule::GetBufferMappedData(const Context& context, BufferHandle buffer)
+{
+    const auto& pool = context.pResources->buffers;
+    return pool.mappedData[pool.slots.Resolve(buffer.value)];
+}
+
+VkImage Aule::GetImage(const Context& context, ImageHandle image)
+{
+    const auto& pool = context.pResources->images;
+    return pool.images[pool.slots.Resolve(image.value)];
+}
+
+VmaAllocation Aule::GetImageAllocation(const Context& context, ImageHandle image)
+{
+    const auto& pool = context.pResources->images;
+    return pool.allocations[pool.slots.Resolve(image.value)];
+}
+
+VkFormat Aule::GetImageFormat(const Context& context, ImageHandle image)
+{
+    const auto& pool = context.pResources->images;
+    return pool.formats[pool.slots.Resolve(image.value)];
+}
+
+VkExtent3D Aule::GetImageExtent(const Context& context, ImageHandle image)
+{
+    const auto& pool = context.pResources->images;
+    return pool.extents[pool.slots.Resolve(image.value)];
+}
+
+VkImageView Aule::GetImageView(const Context& context, ImageViewHandle imageView)
+{
+    const auto& pool = context.pResources->imageViews;
+    return pool.imageViews[pool.slots.Resolve(imageView.value)];
+}
+
+VkSampler Aule::GetSampler(const Context& context, SamplerHandle sampler)
+{
+    const auto& pool = context.pResources->samplers;
+    return pool.samplers[pool.slots.Resolve(sampler.value)];
+}
@@ -0,0 +1,837 @@
+/*
+ * Copyright (c) 2025 John M. Parsaie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AuleInternal.h"
+
+using namespace Aule;
+
+// Internal
+// -----------------------
+
+struct Aule::TextureStreamer
+{
+    struct Texture
+    {
+        StreamedTextureDesc desc;
+
+        // Bumped whenever the slot is released so stale loads can be dropped.
+        uint32_t serial = 0u;
+        bool     alive  = false;
+
+        VkImage       image         = VK_NULL_HANDLE;
+        VmaAllocation allocation    = VK_NULL_HANDLE;
+        VkImageView   view          = VK_NULL_HANDLE;
+        VkDeviceSize  residentBytes = 0u;
+
+        // Finest mip held by `image`, mipCount when nothing is resident yet.
+        uint32_t residentMip = 0u;
+
+        uint32_t requestedMip     = 0u;
+        uint64_t lastRequestFrame = 0u;
+        bool     loadPending      = false;
+    };
+
+    // Loads mips [firstMip, endMip) of a texture into a staging buffer.
+    struct Load
+    {
+        StreamedTexture texture;
+        uint32_t        serial;
+        uint32_t        firstMip;
+        uint32_t        endMip;
+
+        VkBuffer      stagingBuffer;
+        VmaAllocation stagingAllocation;
+        void*         pStagingData;
+
+        std::function<void(uint32_t, void*, size_t)> loadMip;
+        std::vector<VkDeviceSize>                    mipOffsets;
+    };
+
+    TextureStreamerParams params;
+
+    std::vector<Texture>         textures;
+    std::vector<StreamedTexture> freeTextures;
+
+    VkDeviceSize residentBytes = 0u;
+    uint64_t     streamedMips  = 0u;
+    uint64_t     evictedMips   = 0u;
+
+    // Images rebuilt so far, tells whether a frame recorded any commands.
+    uint64_t rebuiltTextures = 0u;
+
+    // Loads that finished on the streaming thread but haven't been uploaded.
+    std::deque<Load> pendingUploads;
+    uint32_t         pendingLoads = 0u;
+
+    // Streaming thread.
+    std::mutex              mutex;
+    std::condition_variable signal;
+    std::deque<Load>        loadQueue;
+    std::deque<Load>        completedLoads;
+    bool                    exit = false;
+    std::thread             loader;
+
+    // Optional dedicated transfer queue, indexed by frame.
+    uint32_t                     transferQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    std::vector<VkCommandPool>   frameTransferCommandPool;
+    std::vector<VkCommandBuffer> frameTransferCommandBuffer;
+    std::vector<VkSemaphore>     frameSemaphoreUploadComplete;
+};
+
+static VkExtent2D GetMipExtent(const StreamedTextureDesc& desc, uint32_t mip)
+{
+    return { std::max(1u, desc.width >> mip), std::max(1u, desc.height >> mip) };
+}
+
+static VkDeviceSize GetMipSize(const StreamedTextureDesc& desc, uint32_t mip)
+{
+    const auto extent = GetMipExtent(desc, mip);
+    return Internal::GetImageSize(desc.format, extent.width, extent.height);
+}
+
+static VkDeviceSize GetResidentSize(const StreamedTextureDesc& desc, uint32_t residentMip)
+{
+    VkDeviceSize size = 0u;
+
+    for (uint32_t mip = residentMip; mip < desc.mipCount; mip++)
+        size += GetMipSize(desc, mip);
+
+    return size;
+}
+
+static void LoaderThread(TextureStreamer* pStreamer)
+{
+    for (;;)
+    {
+        TextureStreamer::Load load;
+        {
+            std::unique_lock lock(pStreamer->mutex);
+
+            pStreamer->signal.wait(
+                lock,
+                [&] { return pStreamer->exit || !pStreamer->loadQueue.empty(); });
+
+            if (pStreamer->exit)
+                return;
+
+            load = std::move(pStreamer->loadQueue.front());
+            pStreamer->loadQueue.pop_front();
+        }
+
+        for (uint32_t mip = load.firstMip; mip < load.endMip; mip++)
+        {
+            const auto offset = load.mipOffsets[mip - load.firstMip];
+            const auto size   = load.mipOffsets[mip - load.firstMip + 1u] - offset;
+
+            load.loadMip(mip, static_cast<uint8_t*>(load.pStagingData) + offset, size);
+        }
+
+        std::lock_guard _(pStreamer->mutex);
+        pStreamer->completedLoads.push_back(std::move(load));
+    }
+}
+
+static void QueueLoad(Context&         ctx,
+                      TextureStreamer& streamer,
+                      StreamedTexture  textureIndex,
+                      uint32_t         firstMip,
+                      uint32_t         endMip)
+{
+    auto& texture = streamer.textures[textureIndex];
+
+    TextureStreamer::Load load = {};
+    {
+        load.texture  = textureIndex;
+        load.serial   = texture.serial;
+        load.firstMip = firstMip;
+        load.endMip   = endMip;
+        load.loadMip  = texture.desc.loadMip;
+
+        load.mipOffsets.push_back(0u);
+
+        for (uint32_t mip = firstMip; mip < endMip; mip++)
+            load.mipOffsets.push_back(load.mipOffsets.back() + GetMipSize(texture.desc, mip));
+    }
+
+    VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    {
+        bufferInfo.size  = load.mipOffsets.back();
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    }
+
+    VmaAllocationCreateInfo allocationInfo = {};
+    {
+        allocationInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+        allocationInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                               VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    }
+
+    VmaAllocationInfo allocationResult;
+    ThrowOnFail(vmaCreateBuffer(ctx.allocator,
+                                &bufferInfo,
+                                &allocationInfo,
+                                &load.stagingBuffer,
+                                &load.stagingAllocation,
+                                &allocationResult));
+
+    load.pStagingData = allocationResult.pMappedData;
+
+    texture.loadPending = true;
+    streamer.pendingLoads++;
+
+    {
+        std::lock_guard _(streamer.mutex);
+        streamer.loadQueue.push_back(std::move(load));
+    }
+    streamer.signal.notify_one();
+}
+
+// Replaces a texture's image with one holding mips [newResidentMip, mipCount).
+// Mips still resident are copied over from the previous image, new ones come
+// from the load's staging buffer. Streamed images stay in GENERAL so in-flight
+// frames can keep sampling the previous image while it is being copied from,
+// without layout transitions across queues.
+static void RebuildTexture(Context&                     ctx,
+                           TextureStreamer&             streamer,
+                           VkCommandBuffer              cmd,
+                           uint32_t                     frameIndex,
+                           TextureStreamer::Texture&    texture,
+                           uint32_t                     newResidentMip,
+                           const TextureStreamer::Load* pLoad)
+{
+    const auto& desc      = texture.desc;
+    const auto  mipLevels = desc.mipCount - newResidentMip;
+    const auto  extent    = GetMipExtent(desc, newResidentMip);
+
+    const uint32_t queueFamilyIndices[] = { ctx.selectedQueueFamilyIndex,
+                                            streamer.transferQueueFamilyIndex };
+
+    VkImageCreateInfo imageInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    {
+        imageInfo.imageType   = VK_IMAGE_TYPE_2D;
+        imageInfo.format      = desc.format;
+        imageInfo.extent      = { extent.width, extent.height, 1u };
+        imageInfo.mipLevels   = mipLevels;
+        imageInfo.arrayLayers = 1u;
+        imageInfo.samples     = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage       = VK_IMAGE_USAGE_SAMPLED_BIT;
+
+        // Transfer source so the resident mips can be carried over on the
+        // next residency change.
+        imageInfo.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+        if (streamer.transferQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED)
+        {
+            imageInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+            imageInfo.queueFamilyIndexCount = 2u;
+            imageInfo.pQueueFamilyIndices   = queueFamilyIndices;
+        }
+    }
+
+    VmaAllocationCreateInfo allocationInfo = {};
+    {
+        allocationInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    }
+
+    VkImage       image;
+    VmaAllocation allocation;
+    ThrowOnFail(
+        vmaCreateImage(ctx.allocator, &imageInfo, &allocationInfo, &image, &allocation, nullptr));
+
+    VkImageView imageView;
+
+    VkImageViewCreateInfo imageViewInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+    {
+        imageViewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+        imageViewInfo.image                       = image;
+        imageViewInfo.format                      = desc.format;
+        imageViewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageViewInfo.subresourceRange.levelCount = mipLevels;
+        imageViewInfo.subresourceRange.layerCount = 1u;
+    }
+    ThrowOnFail(vkCreateImageView(ctx.device, &imageViewInfo, nullptr, &imageView));
+
+    VkImageMemoryBarrier2 imageBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+    {
+        imageBarrier.image                       = image;
+        imageBarrier.oldLayout                   = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageBarrier.newLayout                   = VK_IMAGE_LAYOUT_GENERAL;
+        imageBarrier.srcAccessMask               = VK_ACCESS_2_NONE;
+        imageBarrier.dstAccessMask               = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        imageBarrier.srcStageMask                = VK_PIPELINE_STAGE_2_NONE;
+        imageBarrier.dstStageMask                = VK_PIPELINE_STAGE_2_COPY_BIT;
+        imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageBarrier.subresourceRange.levelCount = mipLevels;
+        imageBarrier.subresourceRange.layerCount = 1u;
+    }
+
+    VkDependencyInfo barriers = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    {
+        barriers.imageMemoryBarrierCount = 1u;
+        barriers.pImageMemoryBarriers    = &imageBarrier;
+    }
+    vkCmdPipelineBarrier2(cmd, &barriers);
+
+    // Mips that survive from the previous image.
+    if (texture.image != VK_NULL_HANDLE)
+    {
+        std::vector<VkImageCopy> copyRegions;
+
+        for (uint32_t mip = std::max(newResidentMip, texture.residentMip); mip < desc.mipCount;
+             mip++)
+        {
+            const auto mipExtent = GetMipExtent(desc, mip);
+
+            VkImageCopy copyRegion = {};
+            {
+                copyRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                copyRegion.srcSubresource.mipLevel   = mip - texture.residentMip;
+                copyRegion.srcSubresource.layerCount = 1u;
+                copyRegion.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                copyRegion.dstSubresource.mipLevel   = mip - newResidentMip;
+                copyRegion.dstSubresource.layerCount = 1u;
+                copyRegion.extent                    = { mipExtent.width, mipExtent.height, 1u };
+            }
+            copyRegions.push_back(copyRegion);
+        }
+
+        vkCmdCopyImage(cmd,
+                       texture.image,
+                       VK_IMAGE_LAYOUT_GENERAL,
+                       image,
+                       VK_IMAGE_LAYOUT_GENERAL,
+                       static_cast<uint32_t>(copyRegions.size()),
+                       copyRegions.data());
+    }
+
+    // Newly loaded mips.
+    if (pLoad)
+    {
+        vmaFlushAllocation(ctx.allocator, pLoad->stagingAllocation, 0u, VK_WHOLE_SIZE);
+
+        std::vector<VkBufferImageCopy> copyRegions;
+
+        for (uint32_t mip = pLoad->firstMip; mip < pLoad->endMip; mip++)
+        {
+            const auto mipExtent = GetMipExtent(desc, mip);
+
+            VkBufferImageCopy copyRegion = {};
+            {
+                copyRegion.bufferOffset                = pLoad->mipOffsets[mip - pLoad->firstMip];
+                copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                copyRegion.imageSubresource.mipLevel   = mip - newResidentMip;
+                copyRegion.imageSubresource.layerCount = 1u;
+                copyRegion.imageExtent = { mipExtent.width, mipExtent.height, 1u };
+            }
+            copyRegions.push_back(copyRegion);
+        }
+
+        vkCmdCopyBufferToImage(cmd,
+                               pLoad->stagingBuffer,
+                               image,
+                               VK_IMAGE_LAYOUT_GENERAL,
+                               static_cast<uint32_t>(copyRegions.size()),
+                               copyRegions.data());
+    }
+
+    {
+        imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_GENERAL;
+        imageBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        imageBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+        imageBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+        imageBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    }
+    vkCmdPipelineBarrier2(cmd, &barriers);
+
+    // Previous image may still be sampled by frames in flight.
+    if (texture.image != VK_NULL_HANDLE)
+    {
+        ctx.frameDeletionQueues[frameIndex].push_back(
+            [device    = ctx.device,
+             allocator = ctx.allocator,
+             image     = texture.image,
+             view      = texture.view,
+             alloc     = texture.allocation]
+            {
+                vkDestroyImageView(device, view, nullptr);
+                vmaDestroyImage(allocator, image, alloc);
+            });
+    }
+
+    const auto newResidentBytes = GetResidentSize(desc, newResidentMip);
+
+    streamer.residentBytes += newResidentBytes;
+    streamer.residentBytes -= texture.residentBytes;
+
+    texture.image         = image;
+    texture.allocation    = allocation;
+    texture.view          = imageView;
+    texture.residentMip   = newResidentMip;
+    texture.residentBytes = newResidentBytes;
+
+    streamer.rebuiltTextures++;
+}
+
+// Requests are stamped by the Dispatch callback, the streamer acts on them at
+// the start of the following frame.
+static uint64_t GetRequestFrame(const Context& ctx) { return ctx.frameNumber - 1u; }
+
+// Textures holding more than their minimum mip tail that weren't requested at
+// their current resolution last frame.
+static bool IsEvictable(const Context&                  ctx,
+                        const TextureStreamer&          streamer,
+                        const TextureStreamer::Texture& texture)
+{
+    if (!texture.alive || texture.loadPending)
+        return false;
+
+    if (texture.residentMip + streamer.params.minResidentMips >= texture.desc.mipCount)
+        return false;
+
+    const bool neededLastFrame = texture.lastRequestFrame == GetRequestFrame(ctx) &&
+                                 texture.requestedMip <= texture.residentMip;
+
+    return !neededLastFrame;
+}
+
+// Drop the finest mip of least recently used textures until `bytesNeeded`
+// more fit in the budget.
+static bool EvictForBudget(Context&         ctx,
+                           TextureStreamer& streamer,
+                           VkCommandBuffer  cmd,
+                           uint32_t         frameIndex,
+                           VkDeviceSize     bytesNeeded,
+                           StreamedTexture  keepTexture)
+{
+    while (streamer.residentBytes + bytesNeeded > streamer.params.vramBudget)
+    {
+        TextureStreamer::Texture* pVictim = nullptr;
+
+        for (uint32_t textureIndex = 0u; textureIndex < streamer.textures.size(); textureIndex++)
+        {
+            auto& texture = streamer.textures[textureIndex];
+
+            if (textureIndex == keepTexture || !IsEvictable(ctx, streamer, texture))
+                continue;
+
+            if (!pVictim || texture.lastRequestFrame < pVictim->lastRequestFrame)
+                pVictim = &texture;
+        }
+
+        if (!pVictim)
+            return false;
+
+        const auto newResidentMip = pVictim->residentMip + 1u;
+
+        RebuildTexture(ctx, streamer, cmd, frameIndex, *pVictim, newResidentMip, nullptr);
+
+        streamer.evictedMips++;
+    }
+
+    return true;
+}
+
+static void DestroyLoad(const Context& ctx, const TextureStreamer::Load& load)
+{
+    vmaDestroyBuffer(ctx.allocator, load.stagingBuffer, load.stagingAllocation);
+}
+
+// Implementation
+// -----------------------
+
+void Aule::CreateTextureStreamer(Context& context, const TextureStreamerParams& params)
+{
+    assert(context.pTextureStreamer == nullptr);
+    assert(params.minResidentMips > 0u);
+
+    auto* pStreamer = new TextureStreamer();
+
+    pStreamer->params = params;
+
+    // Prefer a transfer-only queue family so uploads overlap graphics work.
+    for (uint32_t queueFamilyIndex = 0u; queueFamilyIndex < context.queueFamilyCount;
+         queueFamilyIndex++)
+    {
+        const auto queueFlags = context.queueFamilyProperties[queueFamilyIndex].queueFlags;
+
+        if (!(queueFlags & VK_QUEUE_TRANSFER_BIT))
+            continue;
+
+        if (queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))
+            continue;
+
+        pStreamer->transferQueueFamilyIndex = queueFamilyIndex;
+
+        break;
+    }
+
+    if (pStreamer->transferQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED)
+    {
+        const auto frameCount = context.frameCommandBuffer.size();
+
+        pStreamer->frameTransferCommandPool.resize(frameCount);
+        pStreamer->frameTransferCommandBuffer.resize(frameCount);
+        pStreamer->frameSemaphoreUploadComplete.resize(frameCount);
+
+        for (uint32_t frameIndex = 0u; frameIndex < frameCount; frameIndex++)
+        {
+            VkSemaphoreCreateInfo sempahoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+            ThrowOnFail(vkCreateSemaphore(context.device,
+                                          &sempahoreInfo,
+                                          nullptr,
+                                          &pStreamer->frameSemaphoreUploadComplete[frameIndex]));
+
+            VkCommandPoolCreateInfo commandPoolInfo = {
+                VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO
+            };
+            {
+                commandPoolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+                commandPoolInfo.queueFamilyIndex = pStreamer->transferQueueFamilyIndex;
+            }
+            ThrowOnFail(vkCreateCommandPool(context.device,
+                                            &commandPoolInfo,
+                                            nullptr,
+                                            &pStreamer->frameTransferCommandPool[frameIndex]));
+
+            VkCommandBufferAllocateInfo commandAllocateInfo = {
+                VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO
+            };
+            {
+                commandAllocateInfo.commandBufferCount = 1u;
+                commandAllocateInfo.commandPool = pStreamer->frameTransferCommandPool[frameIndex];
+            }
+            ThrowOnFail(
+                vkAllocateCommandBuffers(context.device,
+                                         &commandAllocateInfo,
+                                         &pStreamer->frameTransferCommandBuffer[frameIndex]));
+        }
+    }
+
+    pStreamer->loader = std::thread(LoaderThread, pStreamer);
+
+    context.pTextureStreamer = pStreamer;
+}
+
+StreamedTexture Aule::AddStreamedTexture(Context& context, const StreamedTextureDesc& desc)
+{
+    auto* pStreamer = context.pTextureStreamer;
+
+    assert(pStreamer != nullptr);
+    assert(desc.mipCount > 0u);
+    assert(desc.loadMip);
+
+    // Only formats with a known texel layout can be staged.
+    ThrowOnFail(Internal::GetImageSize(desc.format, 1u, 1u) != 0u);
+
+    StreamedTexture textureIndex;
+
+    if (!pStreamer->freeTextures.empty())
+    {
+        textureIndex = pStreamer->freeTextures.back();
+        pStreamer->freeTextures.pop_back();
+    }
+    else
+    {
+        textureIndex = static_cast<StreamedTexture>(pStreamer->textures.size());
+        pStreamer->textures.emplace_back();
+    }
+
+    auto& texture = pStreamer->textures[textureIndex];
+    {
+        texture.desc             = desc;
+        texture.alive            = true;
+        texture.residentMip      = desc.mipCount;
+        texture.requestedMip     = desc.mipCount;
+        texture.lastRequestFrame = context.frameNumber;
+    }
+
+    // Start out with just the mip tail.
+    const auto tailMip = desc.mipCount - std::min(desc.mipCount, pStreamer->params.minResidentMips);
+
+    QueueLoad(context, *pStreamer, textureIndex, tailMip, desc.mipCount);
+
+    return textureIndex;
+}
+
+void Aule::RemoveStreamedTexture(Context& context, StreamedTexture textureIndex)
+{
+    auto* pStreamer = context.pTextureStreamer;
+    auto& texture   = pStreamer->textures[textureIndex];
+
+    assert(texture.alive);
+
+    // Destroyed once the frames that may still sample it have finished.
+    if (texture.image != VK_NULL_HANDLE)
+    {
+        context.frameDeletionQueues[context.frameIndex].push_back(
+            [device     = context.device,
+             allocator  = context.allocator,
+             image      = texture.image,
+             view       = texture.view,
+             allocation = texture.allocation]
+            {
+                vkDestroyImageView(device, view, nullptr);
+                vmaDestroyImage(allocator, image, allocation);
+            });
+    }
+
+    pStreamer->residentBytes -= texture.residentBytes;
+
+    // Pending loads are dropped when they complete thanks to the serial.
+    const auto serial = texture.serial + 1u;
+
+    texture        = {};
+    texture.serial = serial;
+
+    pStreamer->freeTextures.push_back(textureIndex);
+}
+
+void Aule::RequestStreamedTextureMip(Context& context, StreamedTexture textureIndex, uint32_t mip)
+{
+    auto& texture = context.pTextureStreamer->textures[textureIndex];
+
+    // Multiple requests in a frame keep the finest one.
+    if (texture.lastRequestFrame != context.frameNumber)
+        texture.requestedMip = mip;
+    else
+        texture.requestedMip = std::min(texture.requestedMip, mip);
+
+    texture.lastRequestFrame = context.frameNumber;
+}
+
+VkImageView Aule::GetStreamedTextureView(const Context& context, StreamedTexture textureIndex)
+{
+    return context.pTextureStreamer->textures[textureIndex].view;
+}
+
+uint32_t Aule::GetStreamedTextureResidentMip(const Context& context, StreamedTexture textureIndex)
+{
+    return context.pTextureStreamer->textures[textureIndex].residentMip;
+}
+
+TextureStreamerStatistics Aule::GetTextureStreamerStatistics(const Context& context)
+{
+    if (!context.pTextureStreamer)
+        return {};
+
+    return { context.pTextureStreamer->residentBytes,
+             context.pTextureStreamer->streamedMips,
+             context.pTextureStreamer->evictedMips };
+}
+
+VkSemaphore Aule::Internal::UpdateTextureStreamer(Context& context, uint32_t frameIndex)
+{
+    auto* pStreamer = context.pTextureStreamer;
+
+    if (!pStreamer)
+        return VK_NULL_HANDLE;
+
+    const bool useTransferQueue = pStreamer->transferQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED;
+
+    // The previous transfer submission for this frame slot is complete, the
+    // frame fence covers it since the frame waited on its semaphore.
+    VkCommandBuffer cmd = context.frameCommandBuffer[frameIndex];
+
+    if (useTransferQueue)
+    {
+        cmd = pStreamer->frameTransferCommandBuffer[frameIndex];
+
+        ThrowOnFail(vkResetCommandPool(context.device,
+                                       pStreamer->frameTransferCommandPool[frameIndex],
+                                       0x0));
+
+        VkCommandBufferBeginInfo cmdInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+        {
+            cmdInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        }
+        ThrowOnFail(vkBeginCommandBuffer(cmd, &cmdInfo));
+    }
+
+    uint32_t uploadCount = 0u;
+
+    const auto rebuiltTextures = pStreamer->rebuiltTextures;
+
+    // Upload finished loads.
+    // -----------------------
+
+    {
+        std::lock_guard _(pStreamer->mutex);
+
+        while (!pStreamer->completedLoads.empty())
+        {
+            pStreamer->pendingUploads.push_back(std::move(pStreamer->completedLoads.front()));
+            pStreamer->completedLoads.pop_front();
+        }
+    }
+
+    while (!pStreamer->pendingUploads.empty() &&
+           uploadCount < pStreamer->params.maxUploadsPerFrame)
+    {
+        auto load = std::move(pStreamer->pendingUploads.front());
+        pStreamer->pendingUploads.pop_front();
+        pStreamer->pendingLoads--;
+
+        // Staging is read by this frame's copy at most.
+        context.frameDeletionQueues[frameIndex].push_back(
+            [allocator = context.allocator,
+             buffer    = load.stagingBuffer,
+             alloc     = load.stagingAllocation] { vmaDestroyBuffer(allocator, buffer, alloc); });
+
+        auto& texture = pStreamer->textures[load.texture];
+
+        // Texture was removed, or its slot reused, while loading.
+        if (!texture.alive || texture.serial != load.serial)
+            continue;
+
+        texture.loadPending = false;
+
+        const auto growth = GetResidentSize(texture.desc, load.firstMip) - texture.residentBytes;
+
+        // Out of budget, retry once some other texture becomes evictable. The
+        // initial mip tail is always uploaded.
+        const bool isMipTail = texture.image == VK_NULL_HANDLE;
+
+        if (!EvictForBudget(context, *pStreamer, cmd, frameIndex, growth, load.texture) &&
+            !isMipTail)
+            continue;
+
+        RebuildTexture(context, *pStreamer, cmd, frameIndex, texture, load.firstMip, &load);
+
+        pStreamer->streamedMips += load.endMip - load.firstMip;
+
+        uploadCount++;
+    }
+
+    // Queue loads for the next finer mip of requested textures.
+    // -----------------------
+
+    // Don't load mips that couldn't be made resident even after evicting
+    // everything evictable, they would just be thrown away.
+    VkDeviceSize allowance = pStreamer->params.vramBudget;
+    {
+        for (const auto& texture : pStreamer->textures)
+        {
+            if (!IsEvictable(context, *pStreamer, texture))
+                continue;
+
+            const auto tailMip = texture.desc.mipCount - pStreamer->params.minResidentMips;
+
+            allowance += texture.residentBytes - GetResidentSize(texture.desc, tailMip);
+        }
+
+        allowance -= std::min(allowance, pStreamer->residentBytes);
+    }
+
+    for (uint32_t textureIndex = 0u; textureIndex < pStreamer->textures.size(); textureIndex++)
+    {
+        if (pStreamer->pendingLoads >= pStreamer->params.maxPendingLoads)
+            break;
+
+        auto& texture = pStreamer->textures[textureIndex];
+
+        if (!texture.alive || texture.loadPending || texture.image == VK_NULL_HANDLE)
+            continue;
+
+        if (texture.lastRequestFrame != GetRequestFrame(context) ||
+            texture.requestedMip >= texture.residentMip)
+            continue;
+
+        const auto growth = GetMipSize(texture.desc, texture.residentMip - 1u);
+
+        if (growth > allowance)
+            continue;
+
+        allowance -= growth;
+
+        QueueLoad(context, *pStreamer, textureIndex, texture.residentMip - 1u, texture.residentMip);
+    }
+
+    if (!useTransferQueue)
+        return VK_NULL_HANDLE;
+
+    ThrowOnFail(vkEndCommandBuffer(cmd));
+
+    // Nothing to wait on, the empty command buffer is reset with its pool.
+    if (pStreamer->rebuiltTextures == rebuiltTextures)
+        return VK_NULL_HANDLE;
+
+    VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    {
+        submitInfo.commandBufferCount   = 1u;
+        submitInfo.pCommandBuffers      = &cmd;
+        submitInfo.signalSemaphoreCount = 1u;
+        submitInfo.pSignalSemaphores    = &pStreamer->frameSemaphoreUploadComplete[frameIndex];
+    }
+    ThrowOnFail(vkQueueSubmit(context.queues[pStreamer->transferQueueFamilyIndex],
+                              1u,
+                              &submitInfo,
+                              VK_NULL_HANDLE));
+
+    return pStreamer->frameSemaphoreUploadComplete[frameIndex];
+}
+
+void Aule::Internal::DestroyTextureStreamer(Context& context)
+{
+    auto* pStreamer = context.pTextureStreamer;
+
+    if (!pStreamer)
+        return;
+
+    {
+        std::lock_guard _(pStreamer->mutex);
+        pStreamer->exit = true;
+    }
+    pStreamer->signal.notify_one();
+    pStreamer->loader.join();
+
+    for (auto* pLoads :
+         { &pStreamer->loadQueue, &pStreamer->completedLoads, &pStreamer->pendingUploads })
+    {
+        for (const auto& load : *pLoads)
+            DestroyLoad(context, load);
+    }
+
+    for (auto& texture : pStreamer->textures)
+    {
+        if (texture.image == VK_NULL_HANDLE)
+            continue;
+
+        vkDestroyImageView(context.device, texture.view, nullptr);
+        vmaDestroyImage(context.allocator, texture.image, texture.allocation);
+    }
+
+    for (uint32_t frameIndex = 0u; frameIndex < pStreamer->frameTransferCommandPool.size();
+         frameIndex++)
+    {
+        vkDestroyCommandPool(context.device,
+                             pStreamer->frameTransferCommandPool[frameIndex],
+                             nullptr);
+        vkDestroySemaphore(context.device,
+                           pStreamer->frameSemaphoreUploadComplete[frameIndex],
+                           nullptr);
+    }
+
+    delete pStreamer;
+
+    context.pTextureStreamer = nullptr;
+}